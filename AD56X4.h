@@ -137,82 +137,467 @@
 
 #include "Arduino.h"
 #include <SPI.h>
+#include "AD56X4Commands.h"
 
-/* For the various defined values, they are chosen so that they
-   are exactly the values that need to be put into the SPI
-   message. This makes it a lot easier to construct the message.
+/* Number of messages the asynchronous queue can hold (one less than
+   this can be waiting at a time). Must be a power of two no bigger
+   than 128. It can be changed by defining it before this header is
+   included and when compiling the library.
 */
 
-#define AD56X4_COMMAND_WRITE_INPUT_REGISTER            B00000000
-#define AD56X4_COMMAND_UPDATE_DAC_REGISTER             B00001000
-#define AD56X4_COMMAND_WRITE_INPUT_REGISTER_UPDATE_ALL B00010000
-#define AD56X4_COMMAND_WRITE_UPDATE_CHANNEL            B00011000
-#define AD56X4_COMMAND_POWER_UPDOWN                    B00100000
-#define AD56X4_COMMAND_RESET                           B00101000
-#define AD56X4_COMMAND_SET_LDAC                        B00110000
-#define AD56X4_COMMAND_REFERENCE_ONOFF                 B00111000
+#ifndef AD56X4_QUEUE_LENGTH
+#define AD56X4_QUEUE_LENGTH 16
+#endif
 
-#define AD56X4_CHANNEL_A                               B00000000
-#define AD56X4_CHANNEL_B                               B00000001
-#define AD56X4_CHANNEL_C                               B00000010
-#define AD56X4_CHANNEL_D                               B00000011
-#define AD56X4_CHANNEL_ALL                             B00000111
+/* Hooks called with every change of a Slave Select pin (LOW or HIGH)
+   and every byte shifted out on MOSI, in the order they happen on
+   the bus. They do nothing unless defined before this header is
+   included (and when compiling the library), which lets a host
+   build record a bit-level trace of exactly what the frame writers
+   emit.
+*/
+
+#ifndef AD56X4_TRACE_SYNC
+#define AD56X4_TRACE_SYNC(level)
+#endif
+#ifndef AD56X4_TRACE_BYTE
+#define AD56X4_TRACE_BYTE(value)
+#endif
+
+
+
+/* Handle for one AD56X4 chip. The Slave Select (SYNC) pin is
+   resolved to its port register and bit mask once, when the handle
+   is constructed, so that sending a frame only has to write the
+   port register instead of going through digitalWrite (on AVR based
+   Arduinos; others still use digitalWrite). Inside a bus session,
+   a handle made for the session's chip copies the one resolved when
+   the session began instead. The pin must still be set to OUTPUT
+   with pinMode.
+*/
+class AD56X4Device
+{
+  
+  public:
+  
+    AD56X4Device (int SS_pin);
+    
+    inline int pin () const
+    {
+      return SS_pin;
+    }
+    
+    // Set the Slave Select pin low and high respectively. Interrupts
+    // are held off while the port register is read, modified, and
+    // written so that an interrupt changing another pin on the same
+    // port can't be clobbered.
+    
+    inline void select () const
+    {
+      AD56X4_TRACE_SYNC(LOW);
+#if defined(__AVR__)
+      uint8_t oldSREG = SREG;
+      cli();
+      *syncOut &= ~syncMask;
+      SREG = oldSREG;
+#else
+      digitalWrite(SS_pin,LOW);
+#endif
+    }
+    inline void deselect () const
+    {
+      AD56X4_TRACE_SYNC(HIGH);
+#if defined(__AVR__)
+      uint8_t oldSREG = SREG;
+      cli();
+      *syncOut |= syncMask;
+      SREG = oldSREG;
+#else
+      digitalWrite(SS_pin,HIGH);
+#endif
+    }
+    
+  private:
+    friend class AD56X4HardwareSPI;
+    friend class AD56X4Class;
+    
+    // An unresolved handle (pin -1), for when no session is open.
+    
+    AD56X4Device ();
+    
+    int SS_pin;
+#if defined(__AVR__)
+    volatile uint8_t *syncOut;
+    uint8_t syncMask;
+#endif
+    
+};
+
+
+
+/* Most Slave Select pins an AD56X4Group can hold. It can be changed
+   by defining it before this header is included and when compiling
+   the library.
+*/
+
+#ifndef AD56X4_GROUP_SIZE
+#define AD56X4_GROUP_SIZE 16
+#endif
 
-#define AD56X4_SETMODE_INPUT                           AD56X4_COMMAND_WRITE_INPUT_REGISTER
-#define AD56X4_SETMODE_INPUT_DAC                       AD56X4_COMMAND_WRITE_UPDATE_CHANNEL
-#define AD56X4_SETMODE_INPUT_DAC_ALL                   AD56X4_COMMAND_WRITE_INPUT_REGISTER_UPDATE_ALL
+/* Handle for a group of AD56X4 chips on the same SPI bus that are
+   all sent the same messages at once by selecting them all together
+   (the chips never talk back, so there is nothing to collide). A
+   group reset, input mode setting, or DAC update then takes one
+   message no matter how many chips there are, and the outputs of all
+   of them change on the same edge. On AVR based Arduinos, the Slave
+   Select pins are merged by port, so pins on the same port are all
+   lowered and raised by a single register write. The pins must still
+   be set to OUTPUT with pinMode.
+*/
+class AD56X4Group
+{
+  
+  public:
+  
+    AD56X4Group ();
+    AD56X4Group (const int SS_pins[], byte count);
+    
+    boolean add (int SS_pin);
+    
+    inline byte size () const
+    {
+      return pinCount;
+    }
+    
+    inline void select () const
+    {
+      AD56X4_TRACE_SYNC(LOW);
+#if defined(__AVR__)
+      uint8_t oldSREG = SREG;
+      cli();
+      for (byte i = 0; i < portCount; i++)
+        *syncOut[i] &= ~syncMask[i];
+      SREG = oldSREG;
+#else
+      for (byte i = 0; i < pinCount; i++)
+        digitalWrite(pins[i],LOW);
+#endif
+    }
+    inline void deselect () const
+    {
+      AD56X4_TRACE_SYNC(HIGH);
+#if defined(__AVR__)
+      uint8_t oldSREG = SREG;
+      cli();
+      for (byte i = 0; i < portCount; i++)
+        *syncOut[i] |= syncMask[i];
+      SREG = oldSREG;
+#else
+      for (byte i = 0; i < pinCount; i++)
+        digitalWrite(pins[i],HIGH);
+#endif
+    }
+    
+  private:
+    byte pinCount;
+#if defined(__AVR__)
+    byte portCount;
+    volatile uint8_t *syncOut[AD56X4_GROUP_SIZE];
+    uint8_t syncMask[AD56X4_GROUP_SIZE];
+#else
+    int pins[AD56X4_GROUP_SIZE];
+#endif
+    
+};
+
+
+
+/* Bus policy (see AD56X4Commands.h) for the hardware SPI bus, with
+   the chip given by an AD56X4Device handle (or a Slave Select pin,
+   which is turned into one). It handles the sessions and
+   asynchronous mode of AD56X4Class.
+*/
+class AD56X4HardwareSPI
+{
+  
+  public:
+  
+    typedef const AD56X4Device &Target;
+    
+    static void writeMessage (Target device, byte header, word data);
+    static void writeMessages (Target device, const byte headers[],
+                               const word data[], byte count);
+    
+  protected:
+    friend class AD56X4Class;
+    friend class AD56X4Device;
+    
+    // Write-only byte transfers. On AVR based Arduinos, startByte
+    // loads SPDR and returns immediately so the next byte can be
+    // prepared while it shifts out, and waitByte waits for it to
+    // finish. SPDR is never read back since the chip has no SDO.
+    // Elsewhere, startByte is a whole SPI.transfer.
+    
+    inline static void startByte (byte value)
+    {
+      AD56X4_TRACE_BYTE(value);
+#if defined(SPDR)
+      SPDR = value;
+#else
+      SPI.transfer(value);
+#endif
+    }
+    inline static void waitByte ()
+    {
+#if defined(SPDR)
+      while (!(SPSR & _BV(SPIF)))
+        ;
+#endif
+    }
+    
+    // Sets up the SPI bus, which is setting the SPI mode to SPI_MODE1
+    // and the bit order to MSB first, unless inside a session where
+    // that has already been done. The clock speed doesn't matter too
+    // much as the chip can go up to 50 MHz while the arduino can only
+    // go up 8 MHz, so we will leave it.
+    
+    inline static void beginFrames ()
+    {
+      if (sessionDevice.pin() < 0)
+        {
+          SPI.setDataMode(SPI_MODE1);
+          SPI.setBitOrder(MSBFIRST);
+        }
+    }
+    
+    /* Sends a 24 bit message to the chip/s selected by handle (an
+       AD56X4Device or AD56X4Group). The message is composed of its
+       first byte holding the command and address bits (header), and
+       a 2-byte unsigned integer data which could be the value to set
+       a channel register to or other control data for other
+       commands.
+    */
+    template <class Handle>
+    inline static void sendMessage (const Handle &handle, byte header,
+                                    word data)
+    {
+      
+      beginFrames();
+      
+      // Set the Slave Select pin to low so that the DAC knows to
+      // listen for a command.
+      
+      handle.select();
+      
+      // Send the header and then the data word byte by byte, MSB
+      // first. Each byte is prepared while the previous one is
+      // shifting out.
+      
+      startByte(header);
+      byte high = highByte(data);
+      byte low = lowByte(data);
+      waitByte();
+      startByte(high);
+      waitByte();
+      startByte(low);
+      waitByte();
+      
+      // Set the Slave Select pin back to high since we are done
+      // sending the command.
+      
+      handle.deselect();
+      
+    }
+    
+    /* Sends count 24 bit messages to the chip/s selected by handle as
+       one burst. The bus is set up once and the next message's bytes
+       are prepared while the last byte of the current one is
+       shifting out, so the only gap between messages is the Slave
+       Select pin going high and back low.
+    */
+    template <class Handle>
+    inline static void sendMessages (const Handle &handle,
+                                     const byte headers[],
+                                     const word data[], byte count)
+    {
+      
+      if (count == 0)
+        return;
+      
+      beginFrames();
+      
+      handle.select();
+      startByte(headers[0]);
+      
+      for (byte i = 0; i < count; i++)
+        {
+          
+          byte high = highByte(data[i]);
+          byte low = lowByte(data[i]);
+          waitByte();
+          startByte(high);
+          waitByte();
+          startByte(low);
+          
+          // Get the next header ready while the last byte shifts out.
+          
+          byte next = 0;
+          if (i + 1 < count)
+            next = headers[i + 1];
+          
+          waitByte();
+          handle.deselect();
+          
+          if (i + 1 < count)
+            {
+              handle.select();
+              startByte(next);
+            }
+          
+        }
+      
+    }
+    
+    // State of the currently open bus session, if any (the chip it
+    // was begun for, resolved, or a pin of -1 if none).
+    
+    static AD56X4Device sessionDevice;
+#if defined(__AVR__)
+    static uint8_t savedSPCR;
+#endif
+    
+    // Queues a message when in asynchronous mode (null otherwise).
+    // It is a pointer so that the queue is only linked in if
+    // beginAsync is used.
+    
+    static const AD56X4Device *asyncDevice;
+    static void (*enqueueMessage) (byte header, word data);
+    
+    // Hold off and let go the queue around sending synchronously to
+    // another chip or group in asynchronous mode.
+    
+    static uint8_t pauseAsync ();
+    static void resumeAsync (uint8_t oldSREG);
+    
+};
 
-#define AD56X4_POWERMODE_NORMAL                        B00000000
-#define AD56X4_POWERMODE_POWERDOWN_1K                  B00010000
-#define AD56X4_POWERMODE_POWERDOWN_100K                B00100000
-#define AD56X4_POWERMODE_TRISTATE                      B00110000
+/* Bus policy (see AD56X4Commands.h) for the hardware SPI bus with the
+   chips given by an AD56X4Group handle. While a chip is in
+   asynchronous mode, groups are sent to with its queue held off.
+*/
+class AD56X4HardwareSPIGroup : public AD56X4HardwareSPI
+{
+  
+  public:
+  
+    typedef const AD56X4Group &Target;
+    
+    static void writeMessage (Target group, byte header, word data);
+    static void writeMessages (Target group, const byte headers[],
+                               const word data[], byte count);
+    
+};
 
 
 
-class AD56X4Class
+/* The library's commands (see AD56X4Commands.h) over the hardware
+   SPI bus. Every command takes the chip's Slave Select pin, an
+   AD56X4Device handle for it, or an AD56X4Group handle for a group of
+   chips as its first argument.
+*/
+class AD56X4Class : public AD56X4Commands<AD56X4HardwareSPI>,
+                    public AD56X4Commands<AD56X4HardwareSPIGroup>
 {
   
+  private:
+    typedef AD56X4Commands<AD56X4HardwareSPI> Single;
+    typedef AD56X4Commands<AD56X4HardwareSPIGroup> Group;
+    
   public:
   
-    static void setChannel (int SS_pin, byte setMode, byte channel,
-                            word value);
-    static void setChannel (int SS_pin, byte setMode, word values[]);
-    static void setChannel (int SS_pin, byte setMode, word value_D,
-                            word value_C, word value_B, word value_A);
-                            
-    static void updateChannel (int SS_pin, byte channel);
-    
-    static void powerUpDown (int SS_pin, byte powerMode,
-                             boolean channels[]);
-    static void powerUpDown (int SS_pin, byte powerMode,
-                             boolean channel_D, boolean channel_C,
-                             boolean channel_B, boolean channel_A);
-    static void powerUpDown (int SS_pin, byte powerModes[]);
-    
-    static void reset (int SS_pin, boolean fullReset);
-    
-    static void setInputMode (int SS_pin, boolean channels[]);
-    static void setInputMode (int SS_pin, boolean channel_D,
-                              boolean channel_C, boolean channel_B,
-                              boolean channel_A);
-    
-    static void useInternalReference (int SS_pin, boolean yesno);
+    using Single::setChannel;
+    using Group::setChannel;
+    using Single::commitChannels;
+    using Group::commitChannels;
+    using Single::updateChannel;
+    using Group::updateChannel;
+    using Single::powerUpDown;
+    using Group::powerUpDown;
+    using Single::reset;
+    using Group::reset;
+    using Single::setInputMode;
+    using Group::setInputMode;
+    using Single::useInternalReference;
+    using Group::useInternalReference;
+    using Single::makeHeader;
+    using Single::makeChannelMask;
+    
+    static void beginSession (int SS_pin);
+    static void beginSession (const AD56X4Device &device);
+    static void endSession ();
+    
+    static boolean beginAsync (const AD56X4Device &device);
+    static void endAsync ();
+    static void flush ();
+    static byte queued ();
+    static byte queueHighWater ();
+    
+    // Used by the SPI interrupt handler defined below.
+    
+    static void asyncInterrupt ();
+    static boolean installAsync ();
     
   private:
-    inline static void powerUpDown (int SS_pin, byte powerMode,
-                                    byte channelMask);
     
-    inline static void setInputMode (int SS_pin, byte channelMask);
+    // Not defined. Catches a Slave Select pin being given, which
+    // would make a temporary handle that is gone before the queue
+    // uses it (see AD56X4Device).
     
-    static word makeChannelMask (boolean channels[]);
-    static word makeChannelMask (boolean channel_D, boolean channel_C,
-                                 boolean channel_B, boolean channel_A);
+    static boolean beginAsync (int SS_pin);
     
-    static void writeMessage (int SS_pin, byte command, byte address,
-                              word data);
+    static boolean asyncInstalled;
     
 };
 
 extern AD56X4Class AD56X4;
 
+/* Convenience object for a bus session. The session is begun when
+   it is constructed and ended either by calling end or when it goes
+   out of scope.
+*/
+class AD56X4Session
+{
+  
+  public:
+  
+    AD56X4Session (int SS_pin);
+    AD56X4Session (const AD56X4Device &device);
+    ~AD56X4Session ();
+    
+    void end ();
+    
+  private:
+    boolean active;
+    
+};
+
+/* The SPI transfer complete interrupt handler for asynchronous mode.
+   It is only defined when AD56X4_ASYNC_ISR is defined before this
+   header is included, which must be done in exactly one file of a
+   sketch using asynchronous mode, so that other sketches can use the
+   SPI interrupt for something else. beginAsync returns false without
+   it.
+   
+     #define AD56X4_ASYNC_ISR
+     #include <AD56X4.h>
+*/
+
+#if defined(AD56X4_ASYNC_ISR) && defined(SPI_STC_vect)
+ISR(SPI_STC_vect)
+{
+  AD56X4Class::asyncInterrupt();
+}
+const boolean AD56X4AsyncInstalled = AD56X4Class::installAsync();
+#endif
+
 #endif 
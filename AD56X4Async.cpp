@@ -0,0 +1,322 @@
+/* Copyright (c) 2026, Freja Nordsiek
+   All rights reserved.
+   
+   Redistribution and use in source and binary forms, with or
+   without modification, are permitted provided that the
+   following conditions are met:
+   
+   1. Redistributions of source code must retain the above
+   copyright notice, this list of conditions and the following disclaimer.
+   
+   2. Redistributions in binary form must reproduce the above
+   copyright notice, this list of conditions and the following
+   disclaimer in the documentation and/or other materials
+   provided with the distribution.
+   
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+   NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+   LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+   HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+   OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*
+   AD56X4Async.cpp: Interrupt driven asynchronous message queue for
+                    the AD56X4 library. The SPI interrupt handler
+                    itself is only defined in a sketch that asks for
+                    it (see AD56X4_ASYNC_ISR in AD56X4.h), so that
+                    sketches not using asynchronous mode are free to
+                    use the SPI interrupt for something else.
+   
+   Author:   Freja Nordsiek
+   Notes:
+   History:  * 2026-10-16 Created.
+*/
+
+#include "Arduino.h"
+#include <SPI.h>
+#include <AD56X4.h>
+
+#if (AD56X4_QUEUE_LENGTH & (AD56X4_QUEUE_LENGTH - 1)) != 0 \
+    || AD56X4_QUEUE_LENGTH > 128
+#error "AD56X4_QUEUE_LENGTH must be a power of two no bigger than 128"
+#endif
+
+// Whether the sketch defined the SPI interrupt handler.
+
+boolean AD56X4Class::asyncInstalled = false;
+
+#if defined(SPI_STC_vect)
+
+/* The queue is a ring of whole 24-bit messages. The message at tail
+   is the one being sent (if sending) and new messages are put at
+   head. The SPI transfer complete interrupt sends the rest of the
+   message at tail one byte at a time, raises the Slave Select pin
+   when it is done, and starts on the next one.
+*/
+
+static volatile byte queue[AD56X4_QUEUE_LENGTH][3];
+static volatile byte head = 0;
+static volatile byte tail = 0;
+static volatile byte byteIndex = 0;
+static volatile boolean sending = false;
+static byte highWater = 0;
+static const AD56X4Device *syncDevice = 0;
+
+#define QUEUE_MASK (AD56X4_QUEUE_LENGTH - 1)
+
+/* Starts sending the message at tail. Interrupts must be off. */
+static inline void startMessage ()
+{
+  sending = true;
+  byteIndex = 0;
+  syncDevice->select();
+  SPDR = queue[tail][0];
+}
+
+/* Does what the SPI transfer complete interrupt would, for when
+   interrupts are off and it can't run: if the byte being sent has
+   shifted out, the flag is cleared (by reading SPSR and then SPDR)
+   and the next byte or message is started. Interrupts must be off.
+*/
+static void pollQueue ()
+{
+  if (sending && (SPSR & _BV(SPIF)))
+    {
+      (void)SPDR;
+      AD56X4Class::asyncInterrupt();
+    }
+}
+
+static void enqueue (byte header, word data)
+{
+  
+  byte next = (head + 1) & QUEUE_MASK;
+  uint8_t oldSREG = SREG;
+  
+  // If the queue is full, wait for the interrupt to make room. If
+  // interrupts are off (e.g. called from another interrupt handler),
+  // it never will, so the queue is sent here by polling until there
+  // is room, making this a blocking send.
+  
+  while (next == tail)
+    if (!(oldSREG & _BV(SREG_I)))
+      pollQueue();
+  
+  queue[head][0] = header;
+  queue[head][1] = highByte(data);
+  queue[head][2] = lowByte(data);
+  
+  // Publish the message and, if the interrupt isn't already busy
+  // sending, start it off on this one.
+  
+  cli();
+  
+  head = next;
+  
+  byte count = (head - tail) & QUEUE_MASK;
+  if (count > highWater)
+    highWater = count;
+  
+  if (!sending)
+    startMessage();
+  
+  SREG = oldSREG;
+  
+}
+
+#endif
+
+/* What the SPI transfer complete interrupt does in asynchronous
+   mode. It is called by the handler AD56X4.h defines when
+   AD56X4_ASYNC_ISR is defined.
+*/
+void AD56X4Class::asyncInterrupt ()
+{
+#if defined(SPI_STC_vect)
+  
+  byte i = byteIndex + 1;
+  
+  if (i < 3)
+    {
+      byteIndex = i;
+      SPDR = queue[tail][i];
+      return;
+    }
+  
+  // The message is done, so raise the Slave Select pin and start the
+  // next one if there is one.
+  
+  syncDevice->deselect();
+  
+  byte t = (tail + 1) & QUEUE_MASK;
+  tail = t;
+  
+  if (t != head)
+    startMessage();
+  else
+    sending = false;
+  
+#endif
+}
+
+/* Called when the sketch defines the SPI interrupt handler. */
+boolean AD56X4Class::installAsync ()
+{
+  asyncInstalled = true;
+  return true;
+}
+
+/* Puts the AD56X4 DAC given by device in asynchronous mode, in which
+   every command sent to it is put on a queue and the function returns
+   immediately, while the SPI transfer complete interrupt sends the
+   queued messages in the background. If the queue is full, a command
+   waits until there is room (with interrupts off, by sending the
+   queue itself, see pollQueue). A session is begun for the chip (the
+   SPI setup is done once here and restored by endAsync), and the SPI
+   interrupt is enabled. Commands for other chips and groups wait for
+   the queue to empty and are then sent synchronously with interrupts
+   held off, and no other kind of device may use the SPI bus until
+   endAsync is called. device must stay around until then. Returns
+   whether asynchronous mode is available (only on AVR based
+   Arduinos, and only if the sketch defines the interrupt handler
+   with AD56X4_ASYNC_ISR), commands being sent synchronously as
+   usual if not.
+*/
+boolean AD56X4Class::beginAsync (const AD56X4Device &device)
+{
+#if defined(SPI_STC_vect)
+  if (!asyncInstalled)
+    return false;
+  
+  if (AD56X4HardwareSPI::enqueueMessage != 0)
+    AD56X4.endAsync();
+  
+  AD56X4.beginSession(device);
+  
+  head = 0;
+  tail = 0;
+  sending = false;
+  highWater = 0;
+  
+  syncDevice = &device;
+  AD56X4HardwareSPI::asyncDevice = &device;
+  AD56X4HardwareSPI::enqueueMessage = enqueue;
+  SPCR |= _BV(SPIE);
+  
+  return true;
+#else
+  (void)device;
+  return false;
+#endif
+}
+
+/* Waits for all queued messages to be sent and then leaves
+   asynchronous mode, disabling the SPI interrupt and ending the
+   session.
+*/
+void AD56X4Class::endAsync ()
+{
+#if defined(SPI_STC_vect)
+  if (AD56X4HardwareSPI::enqueueMessage == 0)
+    return;
+  
+  AD56X4.flush();
+  
+  SPCR &= ~_BV(SPIE);
+  AD56X4HardwareSPI::enqueueMessage = 0;
+  AD56X4HardwareSPI::asyncDevice = 0;
+  
+  AD56X4.endSession();
+#endif
+}
+
+/* Waits until every queued message has been sent (the Slave Select
+   pin has been raised after the last one). If interrupts are off, the
+   SPI interrupt can't send them, so they are sent here by polling
+   instead (see pollQueue), which makes it safe to call (and endAsync
+   with it) from an interrupt handler or with interrupts turned off.
+*/
+void AD56X4Class::flush ()
+{
+#if defined(SPI_STC_vect)
+  while (sending)
+    if (!(SREG & _BV(SREG_I)))
+      pollQueue();
+#endif
+}
+
+/* Returns the number of messages that are queued or being sent. */
+byte AD56X4Class::queued ()
+{
+#if defined(SPI_STC_vect)
+  uint8_t oldSREG = SREG;
+  cli();
+  byte count = (head - tail) & QUEUE_MASK;
+  SREG = oldSREG;
+  return count;
+#else
+  return 0;
+#endif
+}
+
+/* Returns the most messages that have been queued or being sent at
+   once since beginAsync was called.
+*/
+byte AD56X4Class::queueHighWater ()
+{
+#if defined(SPI_STC_vect)
+  return highWater;
+#else
+  return 0;
+#endif
+}
+
+/* Holds off the queue so that another chip or group can be sent to
+   synchronously: waits for the queue to empty (sending it by polling
+   if interrupts are off, see pollQueue) and then leaves interrupts
+   off until resumeAsync, so that nothing can be queued or started in
+   the middle of the synchronous message/s. Returns the status
+   register to give resumeAsync.
+*/
+uint8_t AD56X4HardwareSPI::pauseAsync ()
+{
+#if defined(SPI_STC_vect)
+  for (;;)
+    {
+      uint8_t oldSREG = SREG;
+      cli();
+      if (!sending)
+        return oldSREG;
+      if (!(oldSREG & _BV(SREG_I)))
+        pollQueue();
+      SREG = oldSREG;
+    }
+#else
+  return 0;
+#endif
+}
+
+/* Lets the queue go again after pauseAsync. The transfer complete
+   flag the synchronous bytes left set is cleared (by reading SPSR
+   and then SPDR) so the interrupt doesn't take it for its own, and
+   interrupts are restored with oldSREG.
+*/
+void AD56X4HardwareSPI::resumeAsync (uint8_t oldSREG)
+{
+#if defined(SPI_STC_vect)
+  (void)SPSR;
+  (void)SPDR;
+  SREG = oldSREG;
+#else
+  (void)oldSREG;
+#endif
+}
@@ -0,0 +1,202 @@
+/* Copyright (c) 2026, Freja Nordsiek
+   All rights reserved.
+   
+   Redistribution and use in source and binary forms, with or
+   without modification, are permitted provided that the
+   following conditions are met:
+   
+   1. Redistributions of source code must retain the above
+   copyright notice, this list of conditions and the following disclaimer.
+   
+   2. Redistributions in binary form must reproduce the above
+   copyright notice, this list of conditions and the following
+   disclaimer in the documentation and/or other materials
+   provided with the distribution.
+   
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+   NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+   LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+   HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+   OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*
+   AD56X4Bank.h: Bank of AD56X4 chips on the same bus addressed by
+                 logical channel number.
+   
+   Author:   Freja Nordsiek
+   Notes:    Doesn't need Arduino.h.
+   History:  * 2026-10-16 Created.
+*/
+
+/* An AD56X4Bank is N chips on the bus Bus whose channels are numbered
+   0 through 4N-1, chip by chip (logical channel 4*k + c is channel c,
+   A through D being 0 through 3, of the k'th chip). Values are staged
+   for any set of logical channels (stage, or all of them at once from
+   an array in logical channel order) and then sent by commit, which
+   goes chip by chip so that each chip only gets one burst (one bus
+   setup) with only the channels staged for it. Each chip's outputs
+   change together, with the messages made by
+   AD56X4Commands::makeCommitMessages: when all four channels are
+   staged, it is four messages (one if they are all the same value),
+   a single channel is written and updated by itself, and otherwise
+   the last channel written updates all of them.
+   
+   For all the chips' outputs to change together, commit can write
+   just the input registers, after which all the DAC registers can be
+   updated in one message to an AD56X4Group holding all the chips.
+   
+     AD56X4Device chips[] = {2, 3, 4, 5, 6, 7, 8, 9};
+     AD56X4Bank<AD56X4HardwareSPI> bank(chips, 8);
+     
+     bank.stage(values);   // 32 values.
+     bank.commit();
+*/
+
+#ifndef AD56X4Bank_h
+#define AD56X4Bank_h
+
+#include "AD56X4Commands.h"
+
+/* Most chips an AD56X4Bank can hold. It can be changed by defining it
+   before this header is included.
+*/
+
+#ifndef AD56X4_BANK_SIZE
+#define AD56X4_BANK_SIZE 8
+#endif
+
+/* The type a bus's Target refers to (e.g. AD56X4Device for
+   const AD56X4Device &), so that an array of chips can be held.
+*/
+template <class T>
+struct AD56X4TargetType
+{
+  typedef T Type;
+};
+template <class T>
+struct AD56X4TargetType<T &>
+{
+  typedef T Type;
+};
+
+template <class Bus>
+class AD56X4Bank
+{
+  
+  public:
+  
+    typedef typename AD56X4TargetType<typename Bus::Target>::Type Chip;
+    
+    /* The bank is the first count chips in chips (at most
+       AD56X4_BANK_SIZE), which must stay around as long as it does.
+       Nothing is staged.
+    */
+    AD56X4Bank (Chip chips[], byte count) : chips(chips)
+    {
+      chipCount = (count > AD56X4_BANK_SIZE) ? AD56X4_BANK_SIZE
+                  : count;
+      for (byte k = 0; k < AD56X4_BANK_SIZE; k++)
+        staged[k] = 0;
+    }
+    
+    inline byte size () const
+    {
+      return chipCount;
+    }
+    inline byte channels () const
+    {
+      return 4 * chipCount;
+    }
+    
+    /* Stages value for logical channel channel, or each logical
+       channel's value from values (in logical channel order).
+       Channels out of range are ignored.
+    */
+    void stage (byte channel, word value)
+    {
+      if (channel >= channels())
+        return;
+      values[channel] = value;
+      staged[channel >> 2] |= 1 << (channel & 3);
+    }
+    void stage (const word bankValues[])
+    {
+      for (byte i = 0; i < channels(); i++)
+        values[i] = bankValues[i];
+      for (byte k = 0; k < chipCount; k++)
+        staged[k] = 0x0F;
+    }
+    
+    /* Sends the staged values chip by chip and unstages them. If
+       update is false, only the input registers are written.
+    */
+    void commit (boolean update = true)
+    {
+      for (byte k = 0; k < chipCount; k++)
+        if (staged[k])
+          {
+            commitChip(k,update);
+            staged[k] = 0;
+          }
+    }
+    
+    /* Stages all the values and commits them. */
+    void update (const word bankValues[])
+    {
+      stage(bankValues);
+      commit();
+    }
+    
+    /* Writes value to logical channel channel right away, updating
+       its output.
+    */
+    void write (byte channel, word value)
+    {
+      if (channel < channels())
+        Commands::setChannel(chips[channel >> 2],
+                             AD56X4_SETMODE_INPUT_DAC,channel & 3,
+                             value);
+    }
+    
+    /* The chip logical channel channel is on. */
+    inline Chip & chip (byte channel)
+    {
+      return chips[channel >> 2];
+    }
+    
+  private:
+    
+    typedef AD56X4Commands<Bus> Commands;
+    
+    void commitChip (byte k, boolean update)
+    {
+      
+      byte headers[4];
+      word data[4];
+      byte count =
+        Commands::makeCommitMessages(values + 4 * k,staged[k],
+                                     update ? AD56X4_SETMODE_INPUT_DAC
+                                     : AD56X4_SETMODE_INPUT,
+                                     headers,data);
+      Bus::writeMessages(chips[k],headers,data,count);
+      
+    }
+    
+    Chip *chips;
+    byte chipCount;
+    
+    word values[4 * AD56X4_BANK_SIZE];
+    byte staged[AD56X4_BANK_SIZE];
+    
+};
+
+#endif
@@ -0,0 +1,120 @@
+/* Copyright (c) 2026, Freja Nordsiek
+   All rights reserved.
+   
+   Redistribution and use in source and binary forms, with or
+   without modification, are permitted provided that the
+   following conditions are met:
+   
+   1. Redistributions of source code must retain the above
+   copyright notice, this list of conditions and the following disclaimer.
+   
+   2. Redistributions in binary form must reproduce the above
+   copyright notice, this list of conditions and the following
+   disclaimer in the documentation and/or other materials
+   provided with the distribution.
+   
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+   NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+   LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+   HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+   OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*
+   AD56X4Calibration.cpp: Integer per-channel gain, offset, and
+                          clamping of AD56X4 channel values.
+   
+   Author:   Freja Nordsiek
+   Notes:
+   History:  * 2026-10-16 Created.
+*/
+
+#include "AD56X4Calibration.h"
+
+#if defined(__AVR__)
+#include <avr/eeprom.h>
+#endif
+
+AD56X4Calibration::AD56X4Calibration ()
+{
+  clear();
+}
+
+void AD56X4Calibration::clear ()
+{
+  set(AD56X4_CHANNEL_ALL,AD56X4_CALIBRATION_UNITY,0,0,0xFFFF);
+}
+
+void AD56X4Calibration::set (byte channel, uint16_t gain,
+                             int16_t offset, word minimum,
+                             word maximum)
+{
+  for (byte i = 0; i < 4; i++)
+    if (channel == AD56X4_CHANNEL_ALL || channel == i)
+      {
+        channels[i].gain = gain;
+        channels[i].offset = offset;
+        channels[i].minimum = minimum;
+        channels[i].maximum = maximum;
+      }
+}
+
+/* Sum of the coefficients' bytes, complemented so that an erased
+   EEPROM (all 0xFF) doesn't pass.
+*/
+uint16_t AD56X4Calibration::checksum () const
+{
+  const uint8_t *bytes = (const uint8_t *)channels;
+  uint16_t sum = 0;
+  for (byte i = 0; i < sizeof(channels); i++)
+    sum += bytes[i];
+  return ~sum;
+}
+
+boolean AD56X4Calibration::load (int address)
+{
+#if defined(__AVR__)
+  Channel saved[4];
+  uint16_t savedChecksum;
+  eeprom_read_block(saved,(const void *)address,sizeof(saved));
+  savedChecksum = eeprom_read_word((const uint16_t *)(address
+                                                      + sizeof(saved)));
+  
+  // Check the checksum with the loaded coefficients in place, going
+  // back to the old ones if it doesn't match.
+  
+  Channel old[4];
+  for (byte i = 0; i < 4; i++)
+    {
+      old[i] = channels[i];
+      channels[i] = saved[i];
+    }
+  if (checksum() == savedChecksum)
+    return true;
+  for (byte i = 0; i < 4; i++)
+    channels[i] = old[i];
+  return false;
+#else
+  (void)address;
+  return false;
+#endif
+}
+
+void AD56X4Calibration::save (int address) const
+{
+#if defined(__AVR__)
+  eeprom_update_block(channels,(void *)address,sizeof(channels));
+  eeprom_update_word((uint16_t *)(address + sizeof(channels)),
+                     checksum());
+#else
+  (void)address;
+#endif
+}
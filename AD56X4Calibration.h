@@ -0,0 +1,154 @@
+/* Copyright (c) 2026, Freja Nordsiek
+   All rights reserved.
+   
+   Redistribution and use in source and binary forms, with or
+   without modification, are permitted provided that the
+   following conditions are met:
+   
+   1. Redistributions of source code must retain the above
+   copyright notice, this list of conditions and the following disclaimer.
+   
+   2. Redistributions in binary form must reproduce the above
+   copyright notice, this list of conditions and the following
+   disclaimer in the documentation and/or other materials
+   provided with the distribution.
+   
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+   NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+   LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+   HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+   OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*
+   AD56X4Calibration.h: Integer per-channel gain, offset, and clamping
+                        of AD56X4 channel values.
+   
+   Author:   Freja Nordsiek
+   Notes:    Doesn't need Arduino.h. Loading from and saving to the
+             EEPROM is AVR only.
+   History:  * 2026-10-16 Created.
+*/
+
+/* Boards usually need each channel's values trimmed for gain and
+   offset and kept within a range before they are sent. An
+   AD56X4Calibration holds, for each channel, a gain (unsigned fixed
+   point with 15 fractional bits, so AD56X4_CALIBRATION_UNITY is 1 and
+   the gain can go up to just under 2), an offset in codes, and a
+   minimum and maximum. A value is calibrated as
+   
+     min(max((value * gain + 2^14) / 2^15 + offset, minimum), maximum)
+   
+   using only a 16 by 16 bit multiply and shifts, which on AVR is a
+   small fraction of the cost of doing it in float. The four values
+   of an array (channel D to A order, like setChannel) are done in
+   one pass. The coefficients can be saved to and loaded from the
+   EEPROM (with a checksum so that an erased or stale EEPROM isn't
+   taken for a calibration).
+   
+     AD56X4Calibration calibration;
+     
+     if (!calibration.load(0))
+       calibration.set(AD56X4_CHANNEL_A, 32900, -12, 0, 65000);
+     
+     calibration.applyAll(values, calibrated);
+     AD56X4.commitChannels(dac, calibrated);
+*/
+
+#ifndef AD56X4Calibration_h
+#define AD56X4Calibration_h
+
+#include "AD56X4Commands.h"
+
+/* Gain of one (AD56X4_CALIBRATION_UNITY / 32768). */
+#define AD56X4_CALIBRATION_UNITY 0x8000
+
+class AD56X4Calibration
+{
+  
+  public:
+  
+    // Coefficients of one channel.
+    
+    struct Channel
+    {
+      uint16_t gain;
+      int16_t offset;
+      word minimum;
+      word maximum;
+    };
+    
+    AD56X4Calibration ();
+    
+    /* Sets every channel back to no calibration (a gain of one, no
+       offset, and the whole range).
+    */
+    void clear ();
+    
+    /* Sets the coefficients of a channel (AD56X4_CHANNEL_A through
+       AD56X4_CHANNEL_D, or AD56X4_CHANNEL_ALL for all of them).
+    */
+    void set (byte channel, uint16_t gain, int16_t offset,
+              word minimum = 0, word maximum = 0xFFFF);
+    
+    inline const Channel & coefficients (byte channel) const
+    {
+      return channels[channel & 3];
+    }
+    
+    /* Returns value calibrated for channel (AD56X4_CHANNEL_A through
+       AD56X4_CHANNEL_D).
+    */
+    inline word apply (byte channel, word value) const
+    {
+      return calibrate(channels[channel & 3],value);
+    }
+    
+    /* Calibrates the four values in values (channel D to A order)
+       into calibrated, which may be values itself.
+    */
+    inline void applyAll (const word values[], word calibrated[]) const
+    {
+      calibrated[0] = calibrate(channels[3],values[0]);
+      calibrated[1] = calibrate(channels[2],values[1]);
+      calibrated[2] = calibrate(channels[1],values[2]);
+      calibrated[3] = calibrate(channels[0],values[3]);
+    }
+    
+    /* Loads the coefficients from or saves them to the EEPROM
+       starting at address (taking sizeof(Channel) * 4 + 2 bytes).
+       load returns whether a calibration with a valid checksum was
+       there, leaving the coefficients unchanged if not. Both do
+       nothing (load returning false) on other than AVR.
+    */
+    boolean load (int address);
+    void save (int address) const;
+    
+  private:
+    
+    static inline word calibrate (const Channel &c, word value)
+    {
+      int32_t y = (int32_t)(((uint32_t)value * c.gain + 0x4000) >> 15)
+                  + c.offset;
+      if (y < (int32_t)c.minimum)
+        return c.minimum;
+      if (y > (int32_t)c.maximum)
+        return c.maximum;
+      return (word)y;
+    }
+    
+    uint16_t checksum () const;
+    
+    Channel channels[4];
+    
+};
+
+#endif
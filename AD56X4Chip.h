@@ -0,0 +1,194 @@
+/* Copyright (c) 2026, Freja Nordsiek
+   All rights reserved.
+   
+   Redistribution and use in source and binary forms, with or
+   without modification, are permitted provided that the
+   following conditions are met:
+   
+   1. Redistributions of source code must retain the above
+   copyright notice, this list of conditions and the following disclaimer.
+   
+   2. Redistributions in binary form must reproduce the above
+   copyright notice, this list of conditions and the following
+   disclaimer in the documentation and/or other materials
+   provided with the distribution.
+   
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+   NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+   LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+   HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+   OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*
+   AD56X4Chip.h: AD56X4 commands for a particular member of the
+                 family, chosen at compile time, taking values at the
+                 chip's own resolution.
+   
+   Author:   Freja Nordsiek
+   Notes:    Doesn't need Arduino.h. Needs C++11 (constexpr and
+             static_assert).
+   History:  * 2026-10-16 Created.
+*/
+
+/* The commands in AD56X4Commands take 16-bit values for every chip,
+   with the last 2 or 4 bits ignored by the 14 and 12-bit chips, so a
+   value at the chip's resolution has to be shifted up first. The
+   AD56X4Chip class template is the same commands for one chip
+   variant (AD5624, AD5664, AD5624R, AD5644R, or AD5664R), taking the
+   values at its resolution (0 to fullScale) and doing the shift
+   itself. Since the variant is a template parameter, the shift is a
+   constant (nothing at all for the 16-bit chips), and commands that
+   the chip doesn't have, like useInternalReference on a chip without
+   an internal reference, fail to compile.
+   
+     typedef AD56X4Chip<AD5644R, AD56X4HardwareSPI> DAC;
+     
+     DAC::useInternalReference(device, true);
+     DAC::setChannel(device, AD56X4_SETMODE_INPUT_DAC,
+                     AD56X4_CHANNEL_A, DAC::fullScale / 2);
+*/
+
+#ifndef AD56X4Chip_h
+#define AD56X4Chip_h
+
+#include "AD56X4Commands.h"
+
+/* Description of a chip variant: its resolution in bits and whether
+   it has an internal reference. fullScale is the largest value at
+   that resolution, shift is how far such a value is shifted up in a
+   message, and lsb is how much one step at that resolution is in a
+   16-bit value.
+*/
+template <byte Bits, boolean Reference>
+struct AD56X4Variant
+{
+  static constexpr byte bits = Bits;
+  static constexpr boolean hasInternalReference = Reference;
+  static constexpr byte shift = 16 - Bits;
+  static constexpr word fullScale = (word)((1UL << Bits) - 1);
+  static constexpr word lsb = (word)(1U << (16 - Bits));
+};
+
+// Definitions for when the constants are used by reference.
+
+template <byte Bits, boolean Reference>
+constexpr byte AD56X4Variant<Bits,Reference>::bits;
+template <byte Bits, boolean Reference>
+constexpr boolean AD56X4Variant<Bits,Reference>::hasInternalReference;
+template <byte Bits, boolean Reference>
+constexpr byte AD56X4Variant<Bits,Reference>::shift;
+template <byte Bits, boolean Reference>
+constexpr word AD56X4Variant<Bits,Reference>::fullScale;
+template <byte Bits, boolean Reference>
+constexpr word AD56X4Variant<Bits,Reference>::lsb;
+
+typedef AD56X4Variant<12,false> AD5624;
+typedef AD56X4Variant<16,false> AD5664;
+typedef AD56X4Variant<12,true> AD5624R;
+typedef AD56X4Variant<14,true> AD5644R;
+typedef AD56X4Variant<16,true> AD5664R;
+
+template <class Variant, class Bus>
+class AD56X4Chip : public AD56X4Commands<Bus>
+{
+  
+  private:
+    typedef AD56X4Commands<Bus> Commands;
+    
+  public:
+  
+    typedef typename Bus::Target Target;
+    
+    static constexpr byte bits = Variant::bits;
+    static constexpr word fullScale = Variant::fullScale;
+    static constexpr word lsb = Variant::lsb;
+    
+    /* Turns a value at the chip's resolution into the 16-bit value
+       sent in a message. Values above fullScale are clamped to it
+       (rather than having their top bits shifted out and wrapping
+       around to a low output). The clamp is nothing at all for the
+       16-bit chips.
+    */
+    static constexpr word toWord (word value)
+    {
+      return (word)((value < fullScale ? value : fullScale)
+                    << Variant::shift);
+    }
+    
+    // setChannel and commitChannels as in AD56X4Commands, but with
+    // the values at the chip's resolution. The rest of the commands
+    // are the same.
+    
+    static inline void setChannel (Target target, byte setMode,
+                                   byte channel, word value)
+    {
+      Commands::setChannel(target,setMode,channel,toWord(value));
+    }
+    static inline void setChannel (Target target, byte setMode,
+                                   const word values[])
+    {
+      word shifted[4];
+      shiftValues(values,shifted);
+      Commands::setChannel(target,setMode,shifted);
+    }
+    static inline void setChannel (Target target, byte setMode,
+                                   word value_D, word value_C,
+                                   word value_B, word value_A)
+    {
+      Commands::setChannel(target,setMode,toWord(value_D),
+                           toWord(value_C),toWord(value_B),
+                           toWord(value_A));
+    }
+    
+    static inline void commitChannels (Target target,
+                                       const word values[])
+    {
+      word shifted[4];
+      shiftValues(values,shifted);
+      Commands::commitChannels(target,shifted);
+    }
+    static inline void commitChannels (Target target, word value_D,
+                                       word value_C, word value_B,
+                                       word value_A)
+    {
+      Commands::commitChannels(target,toWord(value_D),
+                               toWord(value_C),toWord(value_B),
+                               toWord(value_A));
+    }
+    
+    static inline void useInternalReference (Target target,
+                                             boolean yesno)
+    {
+      static_assert(Variant::hasInternalReference,
+                    "This AD56X4 chip has no internal reference.");
+      Commands::useInternalReference(target,yesno);
+    }
+    
+  private:
+    
+    static inline void shiftValues (const word values[],
+                                    word shifted[])
+    {
+      for (byte i = 0; i < 4; i++)
+        shifted[i] = toWord(values[i]);
+    }
+    
+};
+
+template <class Variant, class Bus>
+constexpr byte AD56X4Chip<Variant,Bus>::bits;
+template <class Variant, class Bus>
+constexpr word AD56X4Chip<Variant,Bus>::fullScale;
+template <class Variant, class Bus>
+constexpr word AD56X4Chip<Variant,Bus>::lsb;
+
+#endif
@@ -0,0 +1,561 @@
+/* Copyright (c) 2026, Freja Nordsiek
+   All rights reserved.
+   
+   Redistribution and use in source and binary forms, with or
+   without modification, are permitted provided that the
+   following conditions are met:
+   
+   1. Redistributions of source code must retain the above
+   copyright notice, this list of conditions and the following disclaimer.
+   
+   2. Redistributions in binary form must reproduce the above
+   copyright notice, this list of conditions and the following
+   disclaimer in the documentation and/or other materials
+   provided with the distribution.
+   
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+   NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+   LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+   HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+   OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*
+   AD56X4Commands.h: Command layer of the library for controlling the
+                     Analog Devices AD56X4 Quad DAC family, as a
+                     template over the bus (transport) the messages
+                     are sent on. See AD56X4.h for the chips and the
+                     message format.
+   
+   Author:   Freja Nordsiek
+   Notes:    Does not depend on Arduino.h so that it can also be used
+             on other hosts (e.g. Linux).
+   History:  * 2026-10-16 Created.
+*/
+
+/* The commands are all turned into 24 bit messages, each made of a
+   first byte holding the command and address bits (see makeHeader)
+   and a data word, which are then handed to a bus policy class. A
+   bus policy is any class providing
+   
+     typedef ... Target;
+     static void writeMessage (Target target, byte header, word data);
+     static void writeMessages (Target target, const byte headers[],
+                                const word data[], byte count);
+   
+   where Target is whatever identifies the chip on that bus (a
+   Slave Select pin, a device handle, a bus object, ...), and which
+   writes one message or a burst of count messages (each in its own
+   Slave Select cycle) to it. Since everything here is inline and
+   the bus is a template parameter, the compiler can inline the whole
+   path from a command down to the bus with no virtual dispatch. The
+   AD56X4 object in AD56X4.h is this over the hardware SPI bus.
+*/
+
+#ifndef AD56X4Commands_h
+#define AD56X4Commands_h
+
+#if defined(ARDUINO)
+#include "Arduino.h"
+#else
+#include <stdint.h>
+typedef uint8_t byte;
+typedef uint16_t word;
+typedef bool boolean;
+#endif
+
+/* Outside of the Arduino core, flash is just memory. This is for the
+   headers that keep tables in flash (AD56X4Frame.h, AD56X4DDS.h, and
+   AD56X4Wave.h), so they build on other hosts as well.
+*/
+
+#ifndef PROGMEM
+#define PROGMEM
+#endif
+#ifndef pgm_read_byte
+#define pgm_read_byte(address) (*(const uint8_t *)(address))
+#endif
+#ifndef pgm_read_word
+#define pgm_read_word(address) (*(const uint16_t *)(address))
+#endif
+
+/* For the various defined values, they are chosen so that they
+   are exactly the values that need to be put into the SPI
+   message. This makes it a lot easier to construct the message.
+*/
+
+#define AD56X4_COMMAND_WRITE_INPUT_REGISTER            0x00
+#define AD56X4_COMMAND_UPDATE_DAC_REGISTER             0x08
+#define AD56X4_COMMAND_WRITE_INPUT_REGISTER_UPDATE_ALL 0x10
+#define AD56X4_COMMAND_WRITE_UPDATE_CHANNEL            0x18
+#define AD56X4_COMMAND_POWER_UPDOWN                    0x20
+#define AD56X4_COMMAND_RESET                           0x28
+#define AD56X4_COMMAND_SET_LDAC                        0x30
+#define AD56X4_COMMAND_REFERENCE_ONOFF                 0x38
+
+#define AD56X4_CHANNEL_A                               0x00
+#define AD56X4_CHANNEL_B                               0x01
+#define AD56X4_CHANNEL_C                               0x02
+#define AD56X4_CHANNEL_D                               0x03
+#define AD56X4_CHANNEL_ALL                             0x07
+
+#define AD56X4_SETMODE_INPUT                           AD56X4_COMMAND_WRITE_INPUT_REGISTER
+#define AD56X4_SETMODE_INPUT_DAC                       AD56X4_COMMAND_WRITE_UPDATE_CHANNEL
+#define AD56X4_SETMODE_INPUT_DAC_ALL                   AD56X4_COMMAND_WRITE_INPUT_REGISTER_UPDATE_ALL
+
+#define AD56X4_POWERMODE_NORMAL                        0x00
+#define AD56X4_POWERMODE_POWERDOWN_1K                  0x10
+#define AD56X4_POWERMODE_POWERDOWN_100K                0x20
+#define AD56X4_POWERMODE_TRISTATE                      0x30
+
+/* Makes the first byte of a message, which is composed of two bits
+   of nothing, then the command bits, and then the address bits.
+   Masks are used for each set of bits and then the fields are OR'ed
+   together. Every header in the library is made by this (through
+   AD56X4Commands::makeHeader, or directly where there is no bus, as
+   in AD56X4Frame), and it is constexpr where the compiler supports
+   it (C++11) so that frames can be made at compile time.
+*/
+
+#if __cplusplus >= 201103L
+#define AD56X4_CONSTEXPR constexpr
+#else
+#define AD56X4_CONSTEXPR
+#endif
+
+inline AD56X4_CONSTEXPR byte AD56X4MakeHeader (byte command,
+                                               byte address)
+{
+  return (command & 0x38) | (address & 0x07);
+}
+
+
+
+template <class Bus>
+class AD56X4Commands
+{
+  
+  public:
+  
+    typedef typename Bus::Target Target;
+    
+    /* Commands the AD564X DAC given by target to set the values of
+       the specified channel/s. The values are word with the
+       12/14/16-bit values the channels should be set at (last 4 and
+       2 bits are ignored for 12-bit and 14-bit DACs). Either one
+       channel can be set (or all channels set to the same value)
+       with a channel byte that must be one of
+       
+       AD56X4_CHANNEL_A
+       AD56X4_CHANNEL_B
+       AD56X4_CHANNEL_C
+       AD56X4_CHANNEL_D
+       AD56X4_CHANNEL_ALL
+       
+       or separate values (as an array in D to A order or as four
+       separate arguments) be set to each one. There are three ways
+       they can be set, or set modes. They are
+       
+       AD56X4_SETMODE_INPUT          Set the channel/s's input
+                                       register.
+       AD56X4_SETMODE_INPUT_DAC      Set both the input and DAC
+                                       registers for the channel/s.
+       AD56X4_SETMODE_INPUT_DAC_ALL  Set channel/s's input register
+                                       and then update all DAC
+                                       registers from the input
+                                       registers.
+    */
+    static inline void setChannel (Target target, byte setMode,
+                                   byte channel, word value)
+    {
+      // Don't do anything if we weren't given a valid setMode.
+      if (validSetMode(setMode))
+        Bus::writeMessage(target,makeHeader(setMode,channel),value);
+    }
+    static inline void setChannel (Target target, byte setMode,
+                                   const word values[])
+    {
+      // Don't do anything if we weren't given a valid setMode.
+      if (validSetMode(setMode))
+        {
+          // It luckily turns out that channels A through D are
+          // numbers 0 through 3, which we will exploit in the for
+          // loop. The messages are sent as one burst.
+          byte headers[4];
+          for (int i = 3; i >= 0; i--)
+            headers[3-i] = makeHeader(setMode,i);
+          Bus::writeMessages(target,headers,values,4);
+        }
+    }
+    static inline void setChannel (Target target, byte setMode,
+                                   word value_D, word value_C,
+                                   word value_B, word value_A)
+    {
+      word values[] = {value_D,value_C,value_B,value_A};
+      setChannel(target,setMode,values);
+    }
+    
+    /* Commands the AD564X DAC given by target to set all four
+       channels to the given values (an array in D to A order or four
+       separate arguments) with all four outputs changing at the same
+       moment. Channels D, C, and B have just their input registers
+       set and then channel A is set with all the DAC registers
+       updated from the input registers, which is four messages
+       instead of the five for setting the input registers and then
+       updating. If all the values are the same, it is one message
+       setting all channels. The input mode of every channel must be
+       off (see setInputMode) for the outputs to change together.
+    */
+    static inline void commitChannels (Target target,
+                                       const word values[])
+    {
+      word channelValues[4];
+      for (byte i = 0; i < 4; i++)
+        channelValues[i] = values[3-i];
+      byte headers[4];
+      word data[4];
+      byte count = makeCommitMessages(channelValues,0x0F,
+                                      AD56X4_SETMODE_INPUT_DAC_ALL,
+                                      headers,data);
+      Bus::writeMessages(target,headers,data,count);
+    }
+    static inline void commitChannels (Target target, word value_D,
+                                       word value_C, word value_B,
+                                       word value_A)
+    {
+      word values[] = {value_D,value_C,value_B,value_A};
+      commitChannels(target,values);
+    }
+    
+    /* Makes the messages that write the channels in channelMask (bit
+       i for channel i) their values in values (element i for channel
+       i), in D to A order, for commitChannels and anything else that
+       writes some of the channels and then changes their outputs
+       together. setMode says what the last message does:
+       
+       AD56X4_SETMODE_INPUT          Nothing more (only the input
+                                       registers are set).
+       AD56X4_SETMODE_INPUT_DAC      Updates the channels written (a
+                                       single channel just its own DAC
+                                       register, several all the DAC
+                                       registers).
+       AD56X4_SETMODE_INPUT_DAC_ALL  Updates all the DAC registers.
+       
+       All four channels with the same value is one message writing
+       all channels. Returns the number of messages (at most four).
+    */
+    static inline byte makeCommitMessages (const word values[],
+                                           byte channelMask,
+                                           byte setMode,
+                                           byte headers[],
+                                           word data[])
+    {
+      channelMask &= 0x0F;
+      if (channelMask == 0x0F && values[0] == values[1]
+          && values[0] == values[2] && values[0] == values[3])
+        {
+          headers[0] = makeHeader(setMode,AD56X4_CHANNEL_ALL);
+          data[0] = values[0];
+          return 1;
+        }
+      byte count = 0;
+      byte last = 0;
+      for (int i = 3; i >= 0; i--)
+        if (channelMask & (1 << i))
+          {
+            headers[count] = makeHeader(AD56X4_SETMODE_INPUT,i);
+            data[count] = values[i];
+            count++;
+            last = i;
+          }
+      if (count == 0 || setMode == AD56X4_SETMODE_INPUT)
+        return count;
+      if (count > 1)
+        setMode = AD56X4_SETMODE_INPUT_DAC_ALL;
+      headers[count - 1] = makeHeader(setMode,last);
+      return count;
+    }
+    
+    /* Commands the AD564X DAC given by target to update the output
+       (DAC register) of the specified channel from its buffer
+       (input register). The valid channel choices are
+       
+       AD56X4_CHANNEL_A
+       AD56X4_CHANNEL_B
+       AD56X4_CHANNEL_C
+       AD56X4_CHANNEL_D
+       AD56X4_CHANNEL_ALL
+    */
+    static inline void updateChannel (Target target, byte channel)
+    {
+      Bus::writeMessage(target,
+                        makeHeader(AD56X4_COMMAND_UPDATE_DAC_REGISTER,
+                                   channel),0);
+    }
+    
+    /* Commands the AD564X DAC given by target to set the given power
+       mode for the specified channels. The power modes are
+       
+       AD56X4_POWERMODE_NORMAL             normal operation (power up)
+       AD56X4_POWERMODE_POWERDOWN_1K       connected to ground by 1k
+       AD56X4_POWERMODE_POWERDOWN_100K     connected to ground by 100k
+       AD56X4_POWERMODE_POWERDOWN_TRISTATE power down in tristate.
+       
+       A power mode can be applied to a set of channels specified by
+       a channel mask (bits 3 through 0 correspond to channels D
+       through A), a boolean array (in channel D through A order), or
+       four boolean arguments. Or, an array of power modes can be
+       applied to each channel (in D through A order).
+    */
+    static inline void powerUpDown (Target target, byte powerMode,
+                                    byte channelMask)
+    {
+      Bus::writeMessage(target,
+                        makeHeader(AD56X4_COMMAND_POWER_UPDOWN,0),
+                        makePowerData(powerMode,channelMask));
+    }
+    static inline void powerUpDown (Target target, byte powerMode,
+                                    const boolean channels[])
+    {
+      powerUpDown(target,powerMode,makeChannelMask(channels));
+    }
+    static inline void powerUpDown (Target target, byte powerMode,
+                                    boolean channel_D,
+                                    boolean channel_C,
+                                    boolean channel_B,
+                                    boolean channel_A)
+    {
+      powerUpDown(target,powerMode,
+                  makeChannelMask(channel_D,channel_C,channel_B,
+                                  channel_A));
+    }
+    static inline void powerUpDown (Target target,
+                                    const byte powerModes[])
+    {
+      // Channels getting the same power mode share a message, and
+      // the messages are sent as one burst.
+      
+      byte headers[4];
+      word data[4];
+      byte count = groupPowerModes(powerModes,0x0F,data);
+      for (byte i = 0; i < count; i++)
+        headers[i] = makeHeader(AD56X4_COMMAND_POWER_UPDOWN,0);
+      Bus::writeMessages(target,headers,data,count);
+    }
+    
+    /* Commands the AD56X4 DAC given by target to reset. The DAC
+       (output) and input (buffer) registers are set to zero, and if
+       doing a full reset, the channels are all powered up, the
+       external reference is used (internal turned off if present),
+       and all channels set so that writing to the input register
+       does not auto update the DAC register (output).
+    */
+    static inline void reset (Target target, boolean fullReset)
+    {
+      Bus::writeMessage(target,makeHeader(AD56X4_COMMAND_RESET,0),
+                        (word)fullReset);
+    }
+    
+    /* Commands the AD564X DAC given by target which channels are to
+       have their DAC register (output) updated immediately when the
+       input register (buffer) is set. True is for auto update and
+       false is for not. It can either be given as a channel mask
+       (bits 3 through 0 correspond to channels D through A), a
+       boolean array (in channel D through A order), or four boolean
+       arguments.
+    */
+    static inline void setInputMode (Target target, byte channelMask)
+    {
+      Bus::writeMessage(target,makeHeader(AD56X4_COMMAND_SET_LDAC,0),
+                        (word)(channelMask & 0x0F));
+    }
+    static inline void setInputMode (Target target,
+                                     const boolean channels[])
+    {
+      setInputMode(target,makeChannelMask(channels));
+    }
+    static inline void setInputMode (Target target, boolean channel_D,
+                                     boolean channel_C,
+                                     boolean channel_B,
+                                     boolean channel_A)
+    {
+      setInputMode(target,makeChannelMask(channel_D,channel_C,
+                                          channel_B,channel_A));
+    }
+    
+    /* Commands the AD564X DAC given by target whether to use the
+       internal voltage reference or not (use external). Should only
+       be used with chips having an internal reference, which are the
+       ones whose name ends in an R.
+    */
+    static inline void useInternalReference (Target target,
+                                             boolean yesno)
+    {
+      Bus::writeMessage(target,
+                        makeHeader(AD56X4_COMMAND_REFERENCE_ONOFF,0),
+                        (word)yesno);
+    }
+    
+    /* Makes the first byte of a message (see AD56X4MakeHeader). */
+    static inline AD56X4_CONSTEXPR byte makeHeader (byte command,
+                                                    byte address)
+    {
+      return AD56X4MakeHeader(command,address);
+    }
+    
+    /* Create channel masks (byte with bits 3 through 0 corresponding
+       to channels D through A) from an array of booleans for each
+       channel (D to A order) or from 4 argument booleans, one for
+       each channel.
+    */
+    static inline byte makeChannelMask (const boolean channels[])
+    {
+      return makeChannelMask(channels[0],channels[1],channels[2],
+                             channels[3]);
+    }
+    static inline byte makeChannelMask (boolean channel_D,
+                                        boolean channel_C,
+                                        boolean channel_B,
+                                        boolean channel_A)
+    {
+      return (byte)((byte(channel_D) << 3) | (byte(channel_C) << 2)
+                    | (byte(channel_B) << 1) | byte(channel_A));
+    }
+    
+  protected:
+  
+    static inline boolean validSetMode (byte setMode)
+    {
+      return setMode == AD56X4_SETMODE_INPUT 
+             || setMode == AD56X4_SETMODE_INPUT_DAC 
+             || setMode == AD56X4_SETMODE_INPUT_DAC_ALL;
+    }
+    
+    static inline word makePowerData (byte powerMode, byte channelMask)
+    {
+      return (word)((0x30 & powerMode) | (0x0F & channelMask));
+    }
+    
+    /* Makes the data of the power up-down messages that set each
+       channel in channelMask to its power mode in powerModes (element
+       i for channel i), with one message per distinct power mode.
+       Returns the number of messages (at most four).
+    */
+    static inline byte groupPowerModes (const byte powerModes[],
+                                        byte channelMask, word data[])
+    {
+      byte count = 0;
+      byte done = ~channelMask;
+      for (byte i = 0; i < 4; i++)
+        {
+          if (done & (1 << i))
+            continue;
+          byte mode = powerModes[i] & 0x30;
+          byte mask = 0;
+          for (byte j = i; j < 4; j++)
+            if (!(done & (1 << j)) && (powerModes[j] & 0x30) == mode)
+              mask |= 1 << j;
+          done |= mask;
+          data[count++] = makePowerData(mode,mask);
+        }
+      return count;
+    }
+    
+};
+
+
+
+/* The target of a chip that an object keeps for as long as it is
+   around (AD56X4Shadow, AD56X4PowerManager, AD56X4Voltage, and
+   AD56X4Ramp take this in their constructors). It is made from the
+   bus's Target and turns back into it. The targets of the buses are
+   all references, and a Slave Select pin would otherwise quietly
+   become a temporary AD56X4Device that the object is left referring
+   to, so making one from an int fails to compile instead.
+*/
+template <class Bus>
+class AD56X4HeldTarget
+{
+  
+  public:
+  
+    typedef typename Bus::Target Target;
+    
+    AD56X4HeldTarget (Target target) : target(target)
+    {
+    }
+    
+    inline operator Target () const
+    {
+      return target;
+    }
+    
+  private:
+    
+    // Not defined, which is the whole point.
+    
+    AD56X4HeldTarget (int SS_pin);
+    
+    Target target;
+    
+};
+
+
+
+/* Bus policy that doesn't send anything but records the messages it
+   is given into a caller supplied array (up to its size; count keeps
+   counting past that). Useful for checking and counting what a
+   sequence of commands sends, on the Arduino or a host.
+   
+     unsigned long frames[16];
+     AD56X4RecordingBus bus(frames,16);
+     AD56X4Commands<AD56X4RecordingBus>::reset(bus,true);
+*/
+class AD56X4RecordingBus
+{
+  
+  public:
+  
+    typedef AD56X4RecordingBus &Target;
+    
+    AD56X4RecordingBus (unsigned long *frames, unsigned int size)
+    {
+      this->frames = frames;
+      this->size = size;
+      count = 0;
+    }
+    
+    static inline void writeMessage (Target target, byte header,
+                                     word data)
+    {
+      if (target.count < target.size)
+        target.frames[target.count] = ((unsigned long)header << 16)
+                                      | data;
+      target.count++;
+    }
+    static inline void writeMessages (Target target,
+                                      const byte headers[],
+                                      const word data[], byte count)
+    {
+      for (byte i = 0; i < count; i++)
+        writeMessage(target,headers[i],data[i]);
+    }
+    
+    // The recorded messages (24 bits each, first byte in bits 23 to
+    // 16), how many there is room for, and how many were sent.
+    
+    unsigned long *frames;
+    unsigned int size;
+    unsigned int count;
+    
+};
+
+#endif
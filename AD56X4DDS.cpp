@@ -0,0 +1,133 @@
+/* Copyright (c) 2026, Freja Nordsiek
+   All rights reserved.
+   
+   Redistribution and use in source and binary forms, with or
+   without modification, are permitted provided that the
+   following conditions are met:
+   
+   1. Redistributions of source code must retain the above
+   copyright notice, this list of conditions and the following disclaimer.
+   
+   2. Redistributions in binary form must reproduce the above
+   copyright notice, this list of conditions and the following
+   disclaimer in the documentation and/or other materials
+   provided with the distribution.
+   
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+   NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+   LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+   HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+   OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*
+   AD56X4DDS.cpp: Integer direct digital synthesis (DDS) of sine waves
+                  for the four channels of an AD56X4.
+   
+   Author:   Freja Nordsiek
+   Notes:
+   History:  * 2026-10-16 Created.
+*/
+
+#include "AD56X4DDS.h"
+
+const int16_t AD56X4SineTable[257] PROGMEM = {
+  0, 804, 1608, 2410, 3212, 4011, 4808, 5602,
+  6393, 7179, 7962, 8739, 9512, 10278, 11039, 11793,
+  12539, 13279, 14010, 14732, 15446, 16151, 16846, 17530,
+  18204, 18868, 19519, 20159, 20787, 21403, 22005, 22594,
+  23170, 23731, 24279, 24811, 25329, 25832, 26319, 26790,
+  27245, 27683, 28105, 28510, 28898, 29268, 29621, 29956,
+  30273, 30571, 30852, 31113, 31356, 31580, 31785, 31971,
+  32137, 32285, 32412, 32521, 32609, 32678, 32728, 32757,
+  32767, 32757, 32728, 32678, 32609, 32521, 32412, 32285,
+  32137, 31971, 31785, 31580, 31356, 31113, 30852, 30571,
+  30273, 29956, 29621, 29268, 28898, 28510, 28105, 27683,
+  27245, 26790, 26319, 25832, 25329, 24811, 24279, 23731,
+  23170, 22594, 22005, 21403, 20787, 20159, 19519, 18868,
+  18204, 17530, 16846, 16151, 15446, 14732, 14010, 13279,
+  12539, 11793, 11039, 10278, 9512, 8739, 7962, 7179,
+  6393, 5602, 4808, 4011, 3212, 2410, 1608, 804,
+  0, -804, -1608, -2410, -3212, -4011, -4808, -5602,
+  -6393, -7179, -7962, -8739, -9512, -10278, -11039, -11793,
+  -12539, -13279, -14010, -14732, -15446, -16151, -16846, -17530,
+  -18204, -18868, -19519, -20159, -20787, -21403, -22005, -22594,
+  -23170, -23731, -24279, -24811, -25329, -25832, -26319, -26790,
+  -27245, -27683, -28105, -28510, -28898, -29268, -29621, -29956,
+  -30273, -30571, -30852, -31113, -31356, -31580, -31785, -31971,
+  -32137, -32285, -32412, -32521, -32609, -32678, -32728, -32757,
+  -32767, -32757, -32728, -32678, -32609, -32521, -32412, -32285,
+  -32137, -31971, -31785, -31580, -31356, -31113, -30852, -30571,
+  -30273, -29956, -29621, -29268, -28898, -28510, -28105, -27683,
+  -27245, -26790, -26319, -25832, -25329, -24811, -24279, -23731,
+  -23170, -22594, -22005, -21403, -20787, -20159, -19519, -18868,
+  -18204, -17530, -16846, -16151, -15446, -14732, -14010, -13279,
+  -12539, -11793, -11039, -10278, -9512, -8739, -7962, -7179,
+  -6393, -5602, -4808, -4011, -3212, -2410, -1608, -804,
+  0
+};
+
+AD56X4DDS::AD56X4DDS (unsigned long ticksPerSecond)
+  : ticksPerSecond(ticksPerSecond)
+{
+  for (byte i = 0; i < 4; i++)
+    {
+      phase[i] = 0;
+      tuning[i] = 0;
+      phaseOffset[i] = 0;
+      amplitudes[i] = 0;
+      offsets[i] = 0;
+    }
+}
+
+/* The tuning word is milliHertz * 2^32 / (1000 * ticksPerSecond),
+   rounded, which needs 64-bit arithmetic but is only done when the
+   frequency changes.
+*/
+void AD56X4DDS::setFrequency (byte channel, unsigned long milliHertz)
+{
+  uint64_t ticks = (uint64_t)ticksPerSecond * 1000;
+  tuning[channel & 3] = (uint32_t)((((uint64_t)milliHertz << 32)
+                                    + ticks / 2) / ticks);
+}
+
+void AD56X4DDS::restart ()
+{
+  for (byte i = 0; i < 4; i++)
+    phase[i] = 0;
+}
+
+word AD56X4DDS::sample (byte channel) const
+{
+  
+  byte i = channel & 3;
+  uint32_t p = phase[i] + phaseOffset[i];
+  
+  // The top 8 bits of the phase pick the table entry and the next 8
+  // interpolate between it and the next one.
+  
+  byte index = p >> 24;
+  byte fraction = (p >> 16) & 0xFF;
+  int16_t a = (int16_t)pgm_read_word(&AD56X4SineTable[index]);
+  int16_t b = (int16_t)pgm_read_word(&AD56X4SineTable[index + 1]);
+  int16_t s = a + (int16_t)(((int32_t)(b - a) * fraction) >> 8);
+  
+  // Scale by the amplitude (the table is +-2^15) and add the offset,
+  // saturating.
+  
+  int32_t y = (((int32_t)s * amplitudes[i]) >> 15) + offsets[i];
+  if (y < 0)
+    return 0;
+  if (y > 0xFFFF)
+    return 0xFFFF;
+  return (word)y;
+  
+}
@@ -0,0 +1,167 @@
+/* Copyright (c) 2026, Freja Nordsiek
+   All rights reserved.
+   
+   Redistribution and use in source and binary forms, with or
+   without modification, are permitted provided that the
+   following conditions are met:
+   
+   1. Redistributions of source code must retain the above
+   copyright notice, this list of conditions and the following disclaimer.
+   
+   2. Redistributions in binary form must reproduce the above
+   copyright notice, this list of conditions and the following
+   disclaimer in the documentation and/or other materials
+   provided with the distribution.
+   
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+   NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+   LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+   HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+   OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*
+   AD56X4DDS.h: Integer direct digital synthesis (DDS) of sine waves
+                for the four channels of an AD56X4.
+   
+   Author:   Freja Nordsiek
+   Notes:    Doesn't need Arduino.h. The sine table is in
+             AD56X4DDS.cpp.
+   History:  * 2026-10-16 Created.
+*/
+
+/* Working out a sine wave in float for every channel and sample is
+   slow on AVR. An AD56X4DDS does it with integers only: each channel
+   has a 32-bit phase accumulator advanced by a tuning word (2^32 per
+   cycle) for every tick of time, and its sample is read from a 257
+   entry sine table in flash, interpolated linearly with the next 8
+   bits of the phase, scaled by the channel's amplitude, and shifted
+   by its offset (saturating to 0 through 0xFFFF). A tick is
+   whatever the caller advances by: microseconds by default (the
+   difference of two micros() calls), or one sample of a fixed sample
+   rate. Each channel also has a phase offset added to its phase.
+   Changing the frequency only changes the tuning word, so the phase
+   carries on from where it was without a jump.
+   
+     AD56X4DDS dds;
+     
+     for (byte i = 0; i < 4; i++)
+       {
+         dds.setFrequency(i, 10000);   // 10 Hz.
+         dds.setPhase(i, i * 0x4000);  // 90 degrees apart.
+         dds.setAmplitude(i, 32600);
+         dds.setOffset(i, 32768);
+       }
+     
+     unsigned long now = micros();
+     dds.advance(now - last);
+     last = now;
+     dds.samples(values);
+     AD56X4.commitChannels(dac, values);
+*/
+
+#ifndef AD56X4DDS_h
+#define AD56X4DDS_h
+
+#include "AD56X4Commands.h"
+
+/* One cycle of a sine wave in 256 steps (plus the first one again at
+   the end for interpolating), scaled to +-32767.
+*/
+extern const int16_t AD56X4SineTable[257] PROGMEM;
+
+class AD56X4DDS
+{
+  
+  public:
+  
+    /* ticksPerSecond is the rate of the ticks advance is given, which
+       frequencies are worked out against. All channels start at zero
+       frequency, phase, amplitude, and offset.
+    */
+    AD56X4DDS (unsigned long ticksPerSecond = 1000000);
+    
+    // Channels are AD56X4_CHANNEL_A through AD56X4_CHANNEL_D (0
+    // through 3).
+    
+    /* Sets the frequency of a channel in millihertz. */
+    void setFrequency (byte channel, unsigned long milliHertz);
+    
+    /* Sets the phase advance per tick of a channel directly (2^32 is
+       a whole cycle).
+    */
+    inline void setTuningWord (byte channel, uint32_t tuningWord)
+    {
+      tuning[channel & 3] = tuningWord;
+    }
+    inline uint32_t tuningWord (byte channel) const
+    {
+      return tuning[channel & 3];
+    }
+    
+    /* Sets the phase offset of a channel (65536 is a whole cycle, so
+       0x4000 is 90 degrees).
+    */
+    inline void setPhase (byte channel, word phase)
+    {
+      phaseOffset[channel & 3] = (uint32_t)phase << 16;
+    }
+    
+    /* Sets the amplitude (peak, in codes) and offset (the middle of
+       the wave, in codes) of a channel.
+    */
+    inline void setAmplitude (byte channel, word amplitude)
+    {
+      amplitudes[channel & 3] = amplitude;
+    }
+    inline void setOffset (byte channel, word offset)
+    {
+      offsets[channel & 3] = offset;
+    }
+    
+    /* Sets the phase accumulators of all channels back to zero. */
+    void restart ();
+    
+    /* Advances all channels by ticks ticks, or by one. */
+    inline void advance (unsigned long ticks)
+    {
+      for (byte i = 0; i < 4; i++)
+        phase[i] += tuning[i] * ticks;
+    }
+    inline void step ()
+    {
+      for (byte i = 0; i < 4; i++)
+        phase[i] += tuning[i];
+    }
+    
+    /* The sample of a channel at its current phase, or of all four
+       (channel D to A order, for setChannel and commitChannels).
+    */
+    word sample (byte channel) const;
+    inline void samples (word values[]) const
+    {
+      for (byte i = 0; i < 4; i++)
+        values[3-i] = sample(i);
+    }
+    
+  private:
+    
+    unsigned long ticksPerSecond;
+    
+    uint32_t phase[4];
+    uint32_t tuning[4];
+    uint32_t phaseOffset[4];
+    word amplitudes[4];
+    word offsets[4];
+    
+};
+
+#endif
@@ -0,0 +1,174 @@
+/* Copyright (c) 2026, Freja Nordsiek
+   All rights reserved.
+   
+   Redistribution and use in source and binary forms, with or
+   without modification, are permitted provided that the
+   following conditions are met:
+   
+   1. Redistributions of source code must retain the above
+   copyright notice, this list of conditions and the following disclaimer.
+   
+   2. Redistributions in binary form must reproduce the above
+   copyright notice, this list of conditions and the following
+   disclaimer in the documentation and/or other materials
+   provided with the distribution.
+   
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+   NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+   LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+   HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+   OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*
+   AD56X4Frame.h: Prebuilt AD56X4 messages (frames) that can be kept
+                  in flash and sent without any computation.
+   
+   Author:   Freja Nordsiek
+   Notes:    Doesn't need Arduino.h. Needs C++11 (constexpr).
+   History:  * 2026-10-16 Created.
+*/
+
+/* A lot of the messages sent to a chip never change (a full reset,
+   turning the internal reference on, a fixed input mode or power
+   pattern), yet the library functions build them again on every
+   call. An AD56X4Frame is one message, header and data, made by
+   constexpr functions so that it can be worked out at compile time
+   and stored in flash (PROGMEM). AD56X4FrameSender<Bus> sends a frame
+   as is, and a whole table of them (a preset, like a board's
+   initialization) from flash as bursts with one call.
+   
+     const AD56X4Frame boardInit[] PROGMEM = {
+       AD56X4Frame::reset(true),
+       AD56X4Frame::useInternalReference(true),
+       AD56X4Frame::powerUpDown(AD56X4_POWERMODE_TRISTATE, 0x0C),
+       AD56X4Frame::setInputMode(0x00)
+     };
+     
+     AD56X4FrameSender<AD56X4HardwareSPI>::sendPreset(device, boardInit);
+*/
+
+#ifndef AD56X4Frame_h
+#define AD56X4Frame_h
+
+#include "AD56X4Commands.h"
+
+/* Most frames of a preset sent in one burst (longer presets are sent
+   as several). It can be changed by defining it before this header
+   is included.
+*/
+
+#ifndef AD56X4_FRAME_BURST
+#define AD56X4_FRAME_BURST 8
+#endif
+
+struct AD56X4Frame
+{
+  
+  byte header;
+  word data;
+  
+  // Frames for each command, with the same arguments as the library
+  // functions (AD56X4Commands) without the target. Unlike those,
+  // setChannel doesn't check the set mode.
+  
+  static constexpr AD56X4Frame make (byte command, byte address,
+                                     word data)
+  {
+    return AD56X4Frame{AD56X4MakeHeader(command,address),data};
+  }
+  static constexpr AD56X4Frame setChannel (byte setMode, byte channel,
+                                           word value)
+  {
+    return make(setMode,channel,value);
+  }
+  static constexpr AD56X4Frame updateChannel (byte channel)
+  {
+    return make(AD56X4_COMMAND_UPDATE_DAC_REGISTER,channel,0);
+  }
+  static constexpr AD56X4Frame powerUpDown (byte powerMode,
+                                            byte channelMask)
+  {
+    return make(AD56X4_COMMAND_POWER_UPDOWN,0,
+                (word)((powerMode & 0x30) | (channelMask & 0x0F)));
+  }
+  static constexpr AD56X4Frame reset (boolean fullReset)
+  {
+    return make(AD56X4_COMMAND_RESET,0,(word)fullReset);
+  }
+  static constexpr AD56X4Frame setInputMode (byte channelMask)
+  {
+    return make(AD56X4_COMMAND_SET_LDAC,0,(word)(channelMask & 0x0F));
+  }
+  static constexpr AD56X4Frame useInternalReference (boolean yesno)
+  {
+    return make(AD56X4_COMMAND_REFERENCE_ONOFF,0,(word)yesno);
+  }
+  
+};
+
+template <class Bus>
+class AD56X4FrameSender
+{
+  
+  public:
+  
+    typedef typename Bus::Target Target;
+    
+    /* Sends a frame in RAM as is. */
+    static inline void sendFrame (Target target,
+                                  const AD56X4Frame &frame)
+    {
+      Bus::writeMessage(target,frame.header,frame.data);
+    }
+    
+    /* Sends a frame in flash. */
+    static inline void sendFrame_P (Target target,
+                                    const AD56X4Frame *frame)
+    {
+      Bus::writeMessage(target,pgm_read_byte(&frame->header),
+                        pgm_read_word(&frame->data));
+    }
+    
+    /* Sends count frames in flash as bursts of up to
+       AD56X4_FRAME_BURST frames.
+    */
+    static void sendFrames_P (Target target, const AD56X4Frame *frames,
+                              byte count)
+    {
+      byte headers[AD56X4_FRAME_BURST];
+      word data[AD56X4_FRAME_BURST];
+      while (count > 0)
+        {
+          byte n = (count > AD56X4_FRAME_BURST) ? AD56X4_FRAME_BURST
+                   : count;
+          for (byte i = 0; i < n; i++)
+            {
+              headers[i] = pgm_read_byte(&frames[i].header);
+              data[i] = pgm_read_word(&frames[i].data);
+            }
+          Bus::writeMessages(target,headers,data,n);
+          frames += n;
+          count -= n;
+        }
+    }
+    
+    /* Sends a whole array of frames in flash (a preset). */
+    template <byte count>
+    static inline void sendPreset (Target target,
+                                   const AD56X4Frame (&frames)[count])
+    {
+      sendFrames_P(target,frames,count);
+    }
+    
+};
+
+#endif
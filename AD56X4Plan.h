@@ -0,0 +1,316 @@
+/* Copyright (c) 2026, Freja Nordsiek
+   All rights reserved.
+   
+   Redistribution and use in source and binary forms, with or
+   without modification, are permitted provided that the
+   following conditions are met:
+   
+   1. Redistributions of source code must retain the above
+   copyright notice, this list of conditions and the following disclaimer.
+   
+   2. Redistributions in binary form must reproduce the above
+   copyright notice, this list of conditions and the following
+   disclaimer in the documentation and/or other materials
+   provided with the distribution.
+   
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+   NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+   LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+   HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+   OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*
+   AD56X4Plan.h: Staging of several changes to an AD56X4 chip that
+                 are then sent in as few messages as possible.
+   
+   Author:   Freja Nordsiek
+   Notes:    Doesn't need Arduino.h.
+   History:  * 2026-10-16 Created.
+*/
+
+/* Changing several things on the chip at once (a few channel values,
+   some power modes, the input modes) takes one command per change
+   with the library functions, each in the order they are called. An
+   AD56X4Plan is given the state the chip should end up in instead,
+   which is turned into the shortest sequence of messages that gets
+   it there (compile), and then sent on any bus in one burst (send).
+   The messages are
+   
+   1. The internal reference setting, if staged.
+   2. One power up-down message for each power mode other than normal
+      that channels are staged to go to (channels sharing a mode are
+      combined into one mask), so they are off before their values
+      change.
+   3. The staged channel values, with all the outputs changing at the
+      same moment in the last message. When all four channels are
+      staged and some share a value, that value is written to all
+      channels at once and only the others are written after it. A
+      single channel is just written and updated, and otherwise the
+      last channel written updates all the DAC registers (so a
+      channel that isn't staged but whose input register was set
+      without updating its output gets updated as well).
+   4. One power up-down message for the channels staged to be powered
+      up, so they come up at their new values.
+   5. The input modes (LDAC register), if staged.
+   
+   Things that aren't staged are left alone. The plan stays staged
+   after being sent until clear is called.
+   
+     AD56X4Plan plan;
+     
+     plan.setChannel(AD56X4_CHANNEL_A, 1000);
+     plan.setChannel(AD56X4_CHANNEL_B, 1000);
+     plan.powerUpDown(AD56X4_POWERMODE_TRISTATE, 0x0C);  // C and D
+     plan.send<AD56X4HardwareSPI>(device);   // 3 messages.
+*/
+
+#ifndef AD56X4Plan_h
+#define AD56X4Plan_h
+
+#include "AD56X4Commands.h"
+
+/* Most messages a plan can compile to: reference, three power down
+   modes, four values, power up, and input modes.
+*/
+#define AD56X4_PLAN_LENGTH 10
+
+class AD56X4Plan
+{
+  
+  public:
+  
+    AD56X4Plan ()
+    {
+      clear();
+    }
+    
+    /* Unstages everything and forgets the compiled messages. */
+    void clear ()
+    {
+      stagedValues = 0;
+      stagedPower = 0;
+      stagedInputModes = false;
+      stagedReference = false;
+      compiled = false;
+      count = 0;
+    }
+    
+    // Stage changes. The arguments are the same as for the library
+    // functions (AD56X4Commands) without the target, and staging
+    // something again replaces what was staged before.
+    
+    void setChannel (byte channel, word value)
+    {
+      for (byte i = 0; i < 4; i++)
+        if (channel == AD56X4_CHANNEL_ALL || channel == i)
+          {
+            values[i] = value;
+            stagedValues |= 1 << i;
+          }
+      compiled = false;
+    }
+    void setChannel (const word channelValues[])
+    {
+      for (byte i = 0; i < 4; i++)
+        setChannel(i,channelValues[3-i]);
+    }
+    
+    void powerUpDown (byte powerMode, byte channelMask)
+    {
+      for (byte i = 0; i < 4; i++)
+        if (channelMask & (1 << i))
+          {
+            powerModes[i] = powerMode & 0x30;
+            stagedPower |= 1 << i;
+          }
+      compiled = false;
+    }
+    void powerUpDown (const byte channelPowerModes[])
+    {
+      for (byte i = 0; i < 4; i++)
+        powerUpDown(channelPowerModes[i],1 << i);
+    }
+    
+    void setInputMode (byte channelMask)
+    {
+      inputModeMask = channelMask & 0x0F;
+      stagedInputModes = true;
+      compiled = false;
+    }
+    
+    void useInternalReference (boolean yesno)
+    {
+      reference = yesno;
+      stagedReference = true;
+      compiled = false;
+    }
+    
+    /* Turns what is staged into messages and returns how many there
+       are. send does this itself if needed.
+    */
+    byte compile ()
+    {
+      
+      count = 0;
+      
+      if (stagedReference)
+        add(AD56X4_COMMAND_REFERENCE_ONOFF,0,(word)reference);
+      
+      addPowerModes(false);
+      addValues();
+      addPowerModes(true);
+      
+      if (stagedInputModes)
+        add(AD56X4_COMMAND_SET_LDAC,0,inputModeMask);
+      
+      compiled = true;
+      return count;
+      
+    }
+    
+    // The compiled messages.
+    
+    inline byte frameCount () const
+    {
+      return count;
+    }
+    inline const byte * headers () const
+    {
+      return frameHeaders;
+    }
+    inline const word * data () const
+    {
+      return frameData;
+    }
+    
+    /* Sends the plan (compiling it first if needed) to the chip given
+       by target on the bus Bus.
+    */
+    template <class Bus>
+    void send (typename Bus::Target target)
+    {
+      if (!compiled)
+        compile();
+      if (count > 0)
+        Bus::writeMessages(target,frameHeaders,frameData,count);
+    }
+    
+  private:
+    
+    // Headers don't depend on the bus, so any one will do.
+    
+    typedef AD56X4Commands<AD56X4RecordingBus> Commands;
+    
+    void add (byte command, byte channel, word data)
+    {
+      frameHeaders[count] = Commands::makeHeader(command,channel);
+      frameData[count] = data;
+      count++;
+    }
+    
+    /* Adds the power up-down messages for the staged channels that
+       are to be powered up (normal mode) or for those that are to be
+       powered down (the other modes, one message each).
+    */
+    void addPowerModes (boolean up)
+    {
+      byte done = 0;
+      for (byte i = 0; i < 4; i++)
+        {
+          if (!(stagedPower & (1 << i)) || (done & (1 << i))
+              || (powerModes[i] == AD56X4_POWERMODE_NORMAL) != up)
+            continue;
+          byte mask = 0;
+          for (byte j = i; j < 4; j++)
+            if ((stagedPower & (1 << j))
+                && powerModes[j] == powerModes[i])
+              mask |= 1 << j;
+          done |= mask;
+          add(AD56X4_COMMAND_POWER_UPDOWN,0,powerModes[i] | mask);
+        }
+    }
+    
+    void addValues ()
+    {
+      
+      if (stagedValues == 0)
+        return;
+      
+      // Channels still to be written.
+      
+      byte remaining = stagedValues;
+      
+      // If all four are staged, write the most common value to all
+      // of them at once when it is shared by more than one channel
+      // (but not all of them, which is left to makeCommitMessages).
+      
+      if (stagedValues == 0x0F)
+        {
+          byte common = 0;
+          byte commonCount = 0;
+          for (byte i = 0; i < 4; i++)
+            {
+              byte n = 0;
+              for (byte j = 0; j < 4; j++)
+                if (values[j] == values[i])
+                  n++;
+              if (n > commonCount)
+                {
+                  common = i;
+                  commonCount = n;
+                }
+            }
+          if (commonCount > 1 && commonCount < 4)
+            {
+              add(AD56X4_COMMAND_WRITE_INPUT_REGISTER,
+                  AD56X4_CHANNEL_ALL,values[common]);
+              for (byte i = 0; i < 4; i++)
+                if (values[i] == values[common])
+                  remaining &= ~(1 << i);
+            }
+        }
+      
+      // A single channel is written and updated by itself (unless the
+      // common value was written, which needs updating as well).
+      // Otherwise, the input registers are written in D to A order
+      // with the last one updating all the DAC registers.
+      
+      byte setMode = (remaining == stagedValues)
+                     ? AD56X4_SETMODE_INPUT_DAC
+                     : AD56X4_SETMODE_INPUT_DAC_ALL;
+      count += Commands::makeCommitMessages(values,remaining,setMode,
+                                            frameHeaders + count,
+                                            frameData + count);
+      
+    }
+    
+    // Staged state (bit i of the masks for channel i).
+    
+    word values[4];
+    byte stagedValues;
+    byte powerModes[4];
+    byte stagedPower;
+    byte inputModeMask;
+    boolean stagedInputModes;
+    boolean reference;
+    boolean stagedReference;
+    
+    // Compiled messages.
+    
+    boolean compiled;
+    byte count;
+    byte frameHeaders[AD56X4_PLAN_LENGTH];
+    word frameData[AD56X4_PLAN_LENGTH];
+    
+};
+
+#endif
@@ -0,0 +1,353 @@
+/* Copyright (c) 2026, Freja Nordsiek
+   All rights reserved.
+   
+   Redistribution and use in source and binary forms, with or
+   without modification, are permitted provided that the
+   following conditions are met:
+   
+   1. Redistributions of source code must retain the above
+   copyright notice, this list of conditions and the following disclaimer.
+   
+   2. Redistributions in binary form must reproduce the above
+   copyright notice, this list of conditions and the following
+   disclaimer in the documentation and/or other materials
+   provided with the distribution.
+   
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+   NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+   LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+   HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+   OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*
+   AD56X4Power.h: Power manager for an AD56X4 chip that keeps track
+                  of the power mode of each channel and can power
+                  down channels that haven't been written to for a
+                  while.
+   
+   Author:   Freja Nordsiek
+   Notes:
+   History:  * 2026-10-16 Created.
+*/
+
+/* An AD56X4PowerManager keeps track of the power mode of each channel
+   of one chip on the bus Bus, sending one power up-down message per
+   distinct power mode that actually changes. It can also power down
+   channels that are on but haven't been written to for a while (idle)
+   into one of the power down modes, which is done from update (to be
+   called regularly, e.g. in loop), and powers them back up when they
+   are next written to through it. The new value is written before
+   the channel is powered up, so it comes up at that value, which
+   takes about AD56X4_WAKEUP_MICROS microseconds after the message;
+   ready says whether that time has passed.
+   
+     AD56X4Device device(10);
+     AD56X4PowerManager<AD56X4HardwareSPI> power(device);
+     
+     power.setIdlePowerDown(60000, AD56X4_POWERMODE_POWERDOWN_100K);
+     
+     void loop ()
+     {
+       power.update();
+       if (...)
+         power.setChannel(AD56X4_SETMODE_INPUT_DAC, AD56X4_CHANNEL_A,
+                          value);
+     }
+*/
+
+#ifndef AD56X4Power_h
+#define AD56X4Power_h
+
+#include "Arduino.h"
+#include "AD56X4Commands.h"
+
+/* How long (in microseconds) a channel takes to come out of a power
+   down mode (4.5 us typical in the data sheet, rounded up). It can be
+   changed by defining it before this header is included.
+*/
+
+#ifndef AD56X4_WAKEUP_MICROS
+#define AD56X4_WAKEUP_MICROS 5
+#endif
+
+template <class Bus>
+class AD56X4PowerManager
+{
+  
+  public:
+  
+    typedef typename Bus::Target Target;
+    
+    /* The chip is given by target, which must stay around as long as
+       this object. The power modes start out unknown (so the first
+       powerUpDown sends every channel), though idle power down takes
+       them to be normal, the chip's power on mode, until then. Idle
+       power down is off.
+    */
+    AD56X4PowerManager (AD56X4HeldTarget<Bus> target) : target(target)
+    {
+      knownModes = 0;
+      asleep = 0;
+      idleMillis = 0;
+      idleMode = AD56X4_POWERMODE_POWERDOWN_100K;
+      wakeStart = 0;
+      waking = false;
+      unsigned long now = millis();
+      for (byte i = 0; i < 4; i++)
+        {
+          modes[i] = AD56X4_POWERMODE_NORMAL;
+          lastWrite[i] = now;
+        }
+    }
+    
+    /* Sets the channels in channelMask (bits 3 through 0 for channels
+       D through A) to powerMode, or each channel to its element in
+       powerModes (element i for channel i, like
+       AD56X4Commands::powerUpDown). Only channels whose power mode
+       changes are sent, grouped by power mode. Channels powered down
+       for being idle stay that way if set to normal again (they are
+       powered up when next written to), and channels set to normal
+       from a power down mode count as just written to.
+    */
+    void powerUpDown (byte powerMode, byte channelMask)
+    {
+      byte newModes[4];
+      for (byte i = 0; i < 4; i++)
+        newModes[i] = (channelMask & (1 << i)) ? powerMode : modes[i];
+      powerUpDown(newModes);
+    }
+    void powerUpDown (const byte powerModes[])
+    {
+      unsigned long now = millis();
+      byte changed = 0;
+      for (byte i = 0; i < 4; i++)
+        {
+          byte mode = powerModes[i] & 0x30;
+          byte bit = 1 << i;
+          if ((asleep & bit) && mode == AD56X4_POWERMODE_NORMAL)
+            continue;
+          if (!(knownModes & bit) || actualMode(i) != mode)
+            {
+              changed |= bit;
+              if (mode == AD56X4_POWERMODE_NORMAL)
+                lastWrite[i] = now;
+            }
+          asleep &= ~bit;
+          modes[i] = mode;
+        }
+      sendModes(changed);
+    }
+    
+    /* The power mode a channel (AD56X4_CHANNEL_A through
+       AD56X4_CHANNEL_D) is in, which is the idle power down mode if
+       it has been powered down for being idle.
+    */
+    inline byte powerMode (byte channel) const
+    {
+      return actualMode(channel & 3);
+    }
+    
+    /* Mask of the channels powered down for being idle. */
+    inline byte idleChannels () const
+    {
+      return asleep;
+    }
+    
+    /* Channels that are on and haven't been written to for idleMillis
+       milliseconds are powered down into powerMode by update. An
+       idleMillis of zero turns this off.
+    */
+    void setIdlePowerDown (unsigned long idleMillis, byte powerMode)
+    {
+      this->idleMillis = idleMillis;
+      idleMode = powerMode & 0x30;
+    }
+    
+    /* Powers down the channels that have become idle (all in one
+       message). To be called regularly.
+    */
+    void update ()
+    {
+      if (idleMillis == 0)
+        return;
+      unsigned long now = millis();
+      byte idle = 0;
+      for (byte i = 0; i < 4; i++)
+        if (modes[i] == AD56X4_POWERMODE_NORMAL
+            && !(asleep & (1 << i))
+            && now - lastWrite[i] >= idleMillis)
+          idle |= 1 << i;
+      if (idle == 0)
+        return;
+      asleep |= idle;
+      sendModes(idle);
+    }
+    
+    // Writes to the chip like AD56X4Commands::setChannel and
+    // commitChannels, powering the channels written to back up
+    // (after the values are written) if they were idle.
+    
+    void setChannel (byte setMode, byte channel, word value)
+    {
+      if (!Commands::validSetMode(setMode))
+        return;
+      byte header = Commands::makeHeader(setMode,channel);
+      byte channels = (channel == AD56X4_CHANNEL_ALL) ? 0x0F
+                      : (1 << (channel & 3));
+      write(&header,&value,1,channels);
+    }
+    void setChannel (byte setMode, const word values[])
+    {
+      if (!Commands::validSetMode(setMode))
+        return;
+      byte headers[4];
+      for (int i = 3; i >= 0; i--)
+        headers[3-i] = Commands::makeHeader(setMode,i);
+      write(headers,values,4,0x0F);
+    }
+    void commitChannels (const word values[])
+    {
+      word channelValues[4];
+      for (byte i = 0; i < 4; i++)
+        channelValues[i] = values[3-i];
+      byte headers[4];
+      word data[4];
+      byte count =
+        Commands::makeCommitMessages(channelValues,0x0F,
+                                     AD56X4_SETMODE_INPUT_DAC_ALL,
+                                     headers,data);
+      write(headers,data,count,0x0F);
+    }
+    
+    /* Whether the channels last powered up have had the time to come
+       out of power down.
+    */
+    boolean ready ()
+    {
+      if (waking && micros() - wakeStart >= AD56X4_WAKEUP_MICROS)
+        waking = false;
+      return !waking;
+    }
+    
+    /* Waits until ready. */
+    void waitReady ()
+    {
+      while (!ready())
+        ;
+    }
+    
+  private:
+    
+    // Gives access to the protected helpers of the command layer.
+    
+    struct Commands : public AD56X4Commands<Bus>
+    {
+      using AD56X4Commands<Bus>::validSetMode;
+      using AD56X4Commands<Bus>::makePowerData;
+      using AD56X4Commands<Bus>::groupPowerModes;
+    };
+    
+    inline byte actualMode (byte i) const
+    {
+      return (asleep & (1 << i)) ? idleMode : modes[i];
+    }
+    
+    /* Sends the actual power modes of the channels in channelMask,
+       grouped by mode.
+    */
+    void sendModes (byte channelMask)
+    {
+      if (channelMask == 0)
+        return;
+      byte actual[4];
+      byte headers[4];
+      word data[4];
+      for (byte i = 0; i < 4; i++)
+        actual[i] = actualMode(i);
+      byte count = Commands::groupPowerModes(actual,channelMask,data);
+      for (byte i = 0; i < count; i++)
+        headers[i] = Commands::makeHeader(AD56X4_COMMAND_POWER_UPDOWN,0);
+      Bus::writeMessages(target,headers,data,count);
+      knownModes |= channelMask;
+      noteWake(channelMask);
+    }
+    
+    /* Starts the wake up time if any of the channels in channelMask
+       were powered up.
+    */
+    void noteWake (byte channelMask)
+    {
+      for (byte i = 0; i < 4; i++)
+        if ((channelMask & (1 << i))
+            && actualMode(i) == AD56X4_POWERMODE_NORMAL)
+          {
+            wakeStart = micros();
+            waking = true;
+            return;
+          }
+    }
+    
+    /* Sends count messages writing to the channels in channelMask,
+       followed by a power up message if any of them were idle, all as
+       one burst.
+    */
+    void write (const byte headers[], const word data[], byte count,
+                byte channelMask)
+    {
+      unsigned long now = millis();
+      for (byte i = 0; i < 4; i++)
+        if (channelMask & (1 << i))
+          lastWrite[i] = now;
+      
+      byte idle = asleep & channelMask;
+      if (idle == 0)
+        {
+          Bus::writeMessages(target,headers,data,count);
+          return;
+        }
+      
+      byte allHeaders[5];
+      word allData[5];
+      for (byte i = 0; i < count; i++)
+        {
+          allHeaders[i] = headers[i];
+          allData[i] = data[i];
+        }
+      allHeaders[count] =
+        Commands::makeHeader(AD56X4_COMMAND_POWER_UPDOWN,0);
+      allData[count] =
+        Commands::makePowerData(AD56X4_POWERMODE_NORMAL,idle);
+      asleep &= ~idle;
+      Bus::writeMessages(target,allHeaders,allData,count + 1);
+      noteWake(idle);
+    }
+    
+    Target target;
+    
+    // Power mode each channel is meant to be in (bit i of the masks
+    // for channel i), which channels' modes are known, and which are
+    // powered down for being idle.
+    
+    byte modes[4];
+    byte knownModes;
+    byte asleep;
+    
+    unsigned long idleMillis;
+    byte idleMode;
+    unsigned long lastWrite[4];
+    
+    unsigned long wakeStart;
+    boolean waking;
+    
+};
+
+#endif
@@ -0,0 +1,236 @@
+/* Copyright (c) 2026, Freja Nordsiek
+   All rights reserved.
+   
+   Redistribution and use in source and binary forms, with or
+   without modification, are permitted provided that the
+   following conditions are met:
+   
+   1. Redistributions of source code must retain the above
+   copyright notice, this list of conditions and the following disclaimer.
+   
+   2. Redistributions in binary form must reproduce the above
+   copyright notice, this list of conditions and the following
+   disclaimer in the documentation and/or other materials
+   provided with the distribution.
+   
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+   NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+   LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+   HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+   OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*
+   AD56X4Ramp.h: Slew rate limiting of the channels of an AD56X4,
+                 ramping them to new values a step per tick.
+   
+   Author:   Freja Nordsiek
+   Notes:    Doesn't need Arduino.h.
+   History:  * 2026-10-16 Created.
+*/
+
+/* Big steps on the outputs can upset whatever they drive, and
+   ramping with setChannel and delay() in a loop blocks everything
+   else. An AD56X4Ramp gives each channel of one chip on the bus Bus
+   a target and a slew rate (the most its value may change per tick,
+   in codes), and moves the channels towards their targets a step
+   per call of tick, which is to be called at a fixed period (e.g.
+   every millisecond from loop). Only the channels whose values
+   change in a tick are written, all of them changing at the same
+   moment (see AD56X4Commands::makeCommitMessages): one message for a
+   single channel or all four at the same value, and otherwise the
+   changed channels' input registers with all the DAC registers
+   updated in the last message. A new target can be given at any
+   time, and the channel carries on from where it is towards it.
+   
+     AD56X4Ramp<AD56X4HardwareSPI> ramp(device);
+     
+     ramp.setRate(AD56X4_CHANNEL_ALL, 64);
+     ramp.setTarget(AD56X4_CHANNEL_A, 40000);
+     
+     void loop ()
+     {
+       if (millis() - lastTick >= 1)
+         {
+           lastTick += 1;
+           ramp.tick();
+         }
+     }
+   
+   Since several channels are updated together with an update of all
+   DAC registers, no channel may have a value written to its input
+   register but not its output (from outside of the ramp) when tick
+   is called.
+*/
+
+#ifndef AD56X4Ramp_h
+#define AD56X4Ramp_h
+
+#include "AD56X4Commands.h"
+
+template <class Bus>
+class AD56X4Ramp
+{
+  
+  public:
+  
+    typedef typename Bus::Target Target;
+    
+    /* The chip is given by target, which must stay around as long as
+       this object. The channels start out at zero (as after a reset)
+       with no slew rate limit.
+    */
+    AD56X4Ramp (AD56X4HeldTarget<Bus> target) : target(target)
+    {
+      for (byte i = 0; i < 4; i++)
+        {
+          values[i] = 0;
+          targets[i] = 0;
+          rates[i] = 0;
+        }
+    }
+    
+    // Channels are AD56X4_CHANNEL_A through AD56X4_CHANNEL_D, or
+    // AD56X4_CHANNEL_ALL for all four.
+    
+    /* Sets the most a channel's value may change in a tick, in codes.
+       Zero is no limit (the channel goes straight to its target on
+       the next tick).
+    */
+    void setRate (byte channel, word codesPerTick)
+    {
+      for (byte i = 0; i < 4; i++)
+        if (isChannel(channel,i))
+          rates[i] = codesPerTick;
+    }
+    
+    /* Sets the value a channel ramps to, or each channel to its
+       element in channelValues (channel D to A order).
+    */
+    void setTarget (byte channel, word value)
+    {
+      for (byte i = 0; i < 4; i++)
+        if (isChannel(channel,i))
+          targets[i] = value;
+    }
+    void setTarget (const word channelValues[])
+    {
+      for (byte i = 0; i < 4; i++)
+        targets[i] = channelValues[3-i];
+    }
+    
+    /* Sets a channel to a value right away, without ramping, and
+       makes it the target. Nothing is sent for a channel that isn't
+       one.
+    */
+    void jump (byte channel, word value)
+    {
+      if (channel > AD56X4_CHANNEL_D && channel != AD56X4_CHANNEL_ALL)
+        return;
+      setTarget(channel,value);
+      for (byte i = 0; i < 4; i++)
+        if (isChannel(channel,i))
+          values[i] = value;
+      Bus::writeMessage(target,
+                        Commands::makeHeader(AD56X4_SETMODE_INPUT_DAC,
+                                             channel),value);
+    }
+    
+    /* Moves every channel not at its target one step towards it and
+       writes the ones that changed. Returns the channels that changed
+       as a mask (bits 3 through 0 for channels D through A).
+    */
+    byte tick ()
+    {
+      
+      byte changed = 0;
+      
+      for (byte i = 0; i < 4; i++)
+        {
+          word value = values[i];
+          word goal = targets[i];
+          if (value == goal)
+            continue;
+          
+          word distance = goal > value ? goal - value : value - goal;
+          word step = (rates[i] == 0 || rates[i] > distance)
+                      ? distance : rates[i];
+          values[i] = goal > value ? value + step : value - step;
+          changed |= 1 << i;
+        }
+      
+      send(changed);
+      return changed;
+      
+    }
+    
+    /* The value a channel is at, and the value it is ramping to. */
+    inline word value (byte channel) const
+    {
+      return values[channel & 3];
+    }
+    inline word targetValue (byte channel) const
+    {
+      return targets[channel & 3];
+    }
+    
+    /* Whether a channel, or any channel, hasn't reached its target
+       yet.
+    */
+    inline boolean ramping (byte channel) const
+    {
+      return values[channel & 3] != targets[channel & 3];
+    }
+    inline boolean ramping () const
+    {
+      for (byte i = 0; i < 4; i++)
+        if (values[i] != targets[i])
+          return true;
+      return false;
+    }
+    
+  private:
+    
+    typedef AD56X4Commands<Bus> Commands;
+    
+    static inline boolean isChannel (byte channel, byte i)
+    {
+      return channel == AD56X4_CHANNEL_ALL || channel == i;
+    }
+    
+    /* Writes the channels in channelMask so that their outputs all
+       change at once.
+    */
+    void send (byte channelMask)
+    {
+      
+      byte headers[4];
+      word data[4];
+      byte count = Commands::makeCommitMessages(values,channelMask,
+                                                AD56X4_SETMODE_INPUT_DAC,
+                                                headers,data);
+      if (count > 0)
+        Bus::writeMessages(target,headers,data,count);
+      
+    }
+    
+    Target target;
+    
+    // Value, target, and slew rate of each channel (element i for
+    // channel i).
+    
+    word values[4];
+    word targets[4];
+    word rates[4];
+    
+};
+
+#endif
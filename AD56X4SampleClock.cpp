@@ -0,0 +1,345 @@
+/* Copyright (c) 2026, Freja Nordsiek
+   All rights reserved.
+   
+   Redistribution and use in source and binary forms, with or
+   without modification, are permitted provided that the
+   following conditions are met:
+   
+   1. Redistributions of source code must retain the above
+   copyright notice, this list of conditions and the following disclaimer.
+   
+   2. Redistributions in binary form must reproduce the above
+   copyright notice, this list of conditions and the following
+   disclaimer in the documentation and/or other materials
+   provided with the distribution.
+   
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+   NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+   LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+   HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+   OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*
+   AD56X4SampleClock.cpp: Fixed rate output of samples to an AD56X4
+                          from a timer interrupt. The Timer1
+                          interrupt handler itself is only defined in
+                          a sketch that asks for it (see
+                          AD56X4_SAMPLE_CLOCK_ISR in
+                          AD56X4SampleClock.h), so that other
+                          sketches can use Timer1 for something else.
+   
+   Author:   Freja Nordsiek
+   Notes:
+   History:  * 2026-10-16 Created.
+*/
+
+#include "Arduino.h"
+#include <SPI.h>
+#include <AD56X4.h>
+#include <AD56X4SampleClock.h>
+
+#if defined(TIMER1_COMPA_vect) && defined(WGM12)
+#define AD56X4_TIMER1
+#endif
+
+AD56X4SampleClockClass AD56X4SampleClock;
+
+static const AD56X4Device *clockDevice = 0;
+static AD56X4SampleProducer clockProducer = 0;
+static boolean timerInstalled = false;
+
+#if defined(AD56X4_TIMER1)
+
+// Whether the timer is running, its prescaler, and its counts per
+// sample.
+
+static boolean timerRunning = false;
+static word prescale = 0;
+static unsigned long period = 0;
+
+#endif
+
+// Statistics since begin or clearStatistics. worstTicks is in timer
+// counts.
+
+static volatile unsigned long sampleCount = 0;
+static volatile unsigned long overrunCount = 0;
+static volatile unsigned long worstTicks = 0;
+static unsigned long statisticsStart = 0;
+
+/* Reads a counter that the interrupt changes without it changing
+   half way through.
+*/
+static unsigned long readCounter (volatile unsigned long &counter)
+{
+#if defined(__AVR__)
+  uint8_t oldSREG = SREG;
+  cli();
+  unsigned long value = counter;
+  SREG = oldSREG;
+  return value;
+#else
+  return counter;
+#endif
+}
+
+/* What the Timer1 compare interrupt does. It is called by the handler
+   AD56X4SampleClock.h defines when AD56X4_SAMPLE_CLOCK_ISR is defined.
+*/
+void AD56X4SampleClockClass::timerInterrupt ()
+{
+#if defined(AD56X4_TIMER1)
+  
+  unsigned long start = micros();
+  unsigned long fired = TCNT1;
+  
+  tick();
+  
+  // The timer counts up from zero at every compare match, so it now
+  // holds how far into the current period it is. If the next match
+  // has already happened, the periods it passed are skipped (the flag
+  // is cleared so the interrupt doesn't run again straight away and
+  // put the sample out late), and the sample staged goes out at the
+  // match after. The flag is set only once however many matches were
+  // passed, so how many is worked out from how long the interrupt took
+  // by micros(), rounded to make it agree with the timer. micros()
+  // only catches one Timer0 overflow with interrupts off, so past
+  // about a millisecond (at 16 MHz) it is a lower bound.
+  
+  unsigned long elapsed = TCNT1;
+  if (TIFR1 & _BV(OCF1A))
+    {
+      TIFR1 = _BV(OCF1A);
+      unsigned long taken = fired + (micros() - start)
+                            * (F_CPU / 1000000L) / prescale;
+      unsigned long skipped = 1;
+      if (taken > elapsed + period)
+        skipped = (taken - elapsed + period / 2) / period;
+      overrunCount += skipped;
+      elapsed += skipped * period;
+    }
+  if (elapsed > worstTicks)
+    worstTicks = elapsed;
+  
+#endif
+}
+
+/* Called when the sketch defines the Timer1 interrupt handler. */
+boolean AD56X4SampleClockClass::installTimer ()
+{
+  timerInstalled = true;
+  return true;
+}
+
+/* Gets ready to write samples to the AD56X4 DAC given by device, with
+   producer giving them, by ending asynchronous mode if it is on,
+   beginning a session for the chip, and writing the first sample to
+   the input registers. No other device may use the SPI bus, and the
+   chip may not be sent any other commands, until end is called.
+   device must stay around until then. The statistics are cleared.
+*/
+void AD56X4SampleClockClass::begin (const AD56X4Device &device,
+                                    AD56X4SampleProducer producer)
+{
+  
+  if (clockDevice != 0)
+    end();
+  AD56X4.endAsync();
+  AD56X4.beginSession(device);
+  
+  clockDevice = &device;
+  clockProducer = producer;
+  
+  word values[4];
+  producer(values);
+  AD56X4.setChannel(device,AD56X4_SETMODE_INPUT,values);
+  
+  clearStatistics();
+  
+}
+
+/* Starts Timer1 calling tick sampleRate times a second (as near as
+   the timer can get, see sampleRate). Returns whether it could,
+   which needs begin to have been called, an AVR based Arduino, the
+   sketch to define the interrupt handler (AD56X4_SAMPLE_CLOCK_ISR),
+   and a rate the timer can do (about 0.25 Hz to a few hundred kHz at
+   16 MHz, though the interrupt can't keep up long before then).
+*/
+boolean AD56X4SampleClockClass::start (unsigned long sampleRate)
+{
+#if defined(AD56X4_TIMER1)
+  
+  static const word prescalers[] = {1, 8, 64, 256, 1024};
+  
+  if (!timerInstalled || clockDevice == 0 || sampleRate == 0)
+    return false;
+  
+  // Take the smallest prescaler (the finest rate) whose count fits
+  // in the 16-bit timer. The clock select bits are the index plus
+  // one.
+  
+  byte clockSelect = 0;
+  unsigned long count = 0;
+  for (byte i = 0; i < 5 && clockSelect == 0; i++)
+    {
+      unsigned long clock = F_CPU / prescalers[i];
+      count = (clock + sampleRate / 2) / sampleRate;
+      if (count >= 2 && count <= 65536)
+        {
+          clockSelect = i + 1;
+          prescale = prescalers[i];
+        }
+    }
+  if (clockSelect == 0)
+    return false;
+  
+  // Clear timer on compare match (CTC) mode counting to count - 1.
+  
+  uint8_t oldSREG = SREG;
+  cli();
+  TCCR1A = 0;
+  TCCR1B = _BV(WGM12) | clockSelect;
+  OCR1A = count - 1;
+  TCNT1 = 0;
+  TIFR1 = _BV(OCF1A);
+  TIMSK1 |= _BV(OCIE1A);
+  period = count;
+  timerRunning = true;
+  SREG = oldSREG;
+  
+  clearStatistics();
+  return true;
+  
+#else
+  (void)sampleRate;
+  return false;
+#endif
+}
+
+/* Stops the timer and ends the session begun by begin. */
+void AD56X4SampleClockClass::end ()
+{
+  
+#if defined(AD56X4_TIMER1)
+  if (timerRunning)
+    {
+      TIMSK1 &= ~_BV(OCIE1A);
+      TCCR1B = 0;
+      timerRunning = false;
+    }
+#endif
+  
+  if (clockDevice != 0)
+    {
+      AD56X4.endSession();
+      clockDevice = 0;
+    }
+  
+}
+
+/* Writes one sample: updates all four DAC registers from the input
+   registers holding the sample staged by the last tick (or begin),
+   and then gets the next sample from the producer and writes it to
+   the input registers. It is what the timer interrupt does, but can
+   be called from anything else that keeps time instead (another
+   timer's interrupt or an external clock's pin change interrupt) as
+   long as begin has been called.
+*/
+void AD56X4SampleClockClass::tick ()
+{
+  
+  AD56X4.updateChannel(*clockDevice,AD56X4_CHANNEL_ALL);
+  
+  word values[4];
+  clockProducer(values);
+  AD56X4.setChannel(*clockDevice,AD56X4_SETMODE_INPUT,values);
+  
+  sampleCount++;
+  
+}
+
+/* Returns the rate the timer was actually set to by start (it can
+   only divide the CPU clock by whole numbers), or zero if it isn't
+   running.
+*/
+float AD56X4SampleClockClass::sampleRate ()
+{
+#if defined(AD56X4_TIMER1)
+  if (timerRunning)
+    return (float)F_CPU / ((float)prescale * period);
+#endif
+  return 0;
+}
+
+/* Returns the number of samples written per second since the
+   statistics were last cleared. micros() wraps around every 71
+   minutes, so they need clearing more often than that.
+*/
+float AD56X4SampleClockClass::achievedRate ()
+{
+  unsigned long count = readCounter(sampleCount);
+  unsigned long elapsed = micros() - statisticsStart;
+  if (elapsed == 0)
+    return 0;
+  return count * 1e6f / elapsed;
+}
+
+/* Returns the number of samples written since the statistics were
+   last cleared.
+*/
+unsigned long AD56X4SampleClockClass::samples ()
+{
+  return readCounter(sampleCount);
+}
+
+/* Returns the number of periods skipped because the timer interrupt
+   took longer than a period since the statistics were last cleared
+   (the outputs held their values for an extra period for each). An
+   interrupt taking several periods counts them all, worked out from
+   micros(), which makes it a lower bound for one taking longer than
+   about a millisecond.
+*/
+unsigned long AD56X4SampleClockClass::overruns ()
+{
+  return readCounter(overrunCount);
+}
+
+/* Returns the longest the timer interrupt has taken, from the timer
+   firing to it being done, in microseconds since the statistics were
+   last cleared. It is only measured when the timer is running.
+*/
+unsigned long AD56X4SampleClockClass::worstMicros ()
+{
+#if defined(AD56X4_TIMER1)
+  return readCounter(worstTicks) * prescale / (F_CPU / 1000000L);
+#else
+  return 0;
+#endif
+}
+
+/* Clears the statistics, starting the measurement of the achieved
+   rate again.
+*/
+void AD56X4SampleClockClass::clearStatistics ()
+{
+#if defined(__AVR__)
+  uint8_t oldSREG = SREG;
+  cli();
+#endif
+  sampleCount = 0;
+  overrunCount = 0;
+  worstTicks = 0;
+  statisticsStart = micros();
+#if defined(__AVR__)
+  SREG = oldSREG;
+#endif
+}
@@ -0,0 +1,130 @@
+/* Copyright (c) 2026, Freja Nordsiek
+   All rights reserved.
+   
+   Redistribution and use in source and binary forms, with or
+   without modification, are permitted provided that the
+   following conditions are met:
+   
+   1. Redistributions of source code must retain the above
+   copyright notice, this list of conditions and the following disclaimer.
+   
+   2. Redistributions in binary form must reproduce the above
+   copyright notice, this list of conditions and the following
+   disclaimer in the documentation and/or other materials
+   provided with the distribution.
+   
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+   NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+   LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+   HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+   OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*
+   AD56X4SampleClock.h: Fixed rate output of samples to an AD56X4 from
+                        a timer interrupt.
+   
+   Author:   Freja Nordsiek
+   Notes:    Needs Timer1 on AVR based Arduinos (so it can't be used
+             with the Servo library), and AD56X4_SAMPLE_CLOCK_ISR to
+             be defined before this header is included.
+   History:  * 2026-10-16 Created.
+*/
+
+/* Writing samples from loop() gives a sample rate that drifts with
+   whatever else the sketch does, and the jitter in when the outputs
+   change shows up as spurs. The sample clock instead writes them
+   from the Timer1 compare interrupt at a fixed rate. Every sample
+   is staged one period ahead: the first thing the interrupt does is
+   update all four DAC registers from the input registers (so the
+   outputs change a fixed time after the timer fires), and only then
+   calls the producer for the next sample and writes it to the input
+   registers. It keeps the number of samples, the achieved rate, the
+   number of overruns (periods skipped by the interrupt taking longer
+   than a period, the outputs holding their values for an extra
+   period for each), and the longest the interrupt took.
+   
+   The Timer1 interrupt handler is only defined in the one file of a
+   sketch that defines AD56X4_SAMPLE_CLOCK_ISR before including this
+   header, so that sketches that don't use the sample clock can still
+   use Timer1 for something else. start returns false without it.
+   
+     #define AD56X4_SAMPLE_CLOCK_ISR
+     #include <AD56X4SampleClock.h>
+   
+     void nextSample (word values[])
+     {
+       dds.step();
+       dds.samples(values);
+     }
+     
+     AD56X4SampleClock.begin(device, nextSample);
+     AD56X4SampleClock.start(10000);
+*/
+
+#ifndef AD56X4SampleClock_h
+#define AD56X4SampleClock_h
+
+#include "Arduino.h"
+#include <AD56X4.h>
+
+/* Producer of samples. It puts the next values of the four channels
+   in values in channel D to A order. It is called from the interrupt,
+   so it must be quick.
+*/
+typedef void (*AD56X4SampleProducer) (word values[]);
+
+class AD56X4SampleClockClass
+{
+  
+  public:
+  
+    static void begin (const AD56X4Device &device,
+                       AD56X4SampleProducer producer);
+    static boolean start (unsigned long sampleRate);
+    static void end ();
+    
+    static void tick ();
+    
+    static float sampleRate ();
+    static float achievedRate ();
+    static unsigned long samples ();
+    static unsigned long overruns ();
+    static unsigned long worstMicros ();
+    static void clearStatistics ();
+    
+    // Used by the Timer1 interrupt handler defined below.
+    
+    static void timerInterrupt ();
+    static boolean installTimer ();
+    
+  private:
+    
+    // Not defined. Catches a Slave Select pin being given, which
+    // would make a temporary handle that is gone before the interrupt
+    // uses it (see AD56X4Device).
+    
+    static void begin (int SS_pin, AD56X4SampleProducer producer);
+    
+};
+
+extern AD56X4SampleClockClass AD56X4SampleClock;
+
+#if defined(AD56X4_SAMPLE_CLOCK_ISR) && defined(TIMER1_COMPA_vect)
+ISR(TIMER1_COMPA_vect)
+{
+  AD56X4SampleClockClass::timerInterrupt();
+}
+const boolean AD56X4SampleClockInstalled =
+  AD56X4SampleClockClass::installTimer();
+#endif
+
+#endif
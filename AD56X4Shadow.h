@@ -0,0 +1,481 @@
+/* Copyright (c) 2026, Freja Nordsiek
+   All rights reserved.
+   
+   Redistribution and use in source and binary forms, with or
+   without modification, are permitted provided that the
+   following conditions are met:
+   
+   1. Redistributions of source code must retain the above
+   copyright notice, this list of conditions and the following disclaimer.
+   
+   2. Redistributions in binary form must reproduce the above
+   copyright notice, this list of conditions and the following
+   disclaimer in the documentation and/or other materials
+   provided with the distribution.
+   
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+   NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+   LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+   HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+   OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*
+   AD56X4Shadow.h: AD56X4 chip object that keeps a copy (shadow) of
+                   the chip's state and doesn't send messages that
+                   wouldn't change it.
+   
+   Author:   Freja Nordsiek
+   Notes:    Doesn't need Arduino.h.
+   History:  * 2026-10-16 Created.
+*/
+
+/* The chip can't be read back, so the only way to know its state is
+   to keep track of every message sent to it. AD56X4Shadow keeps
+   shadows of the input and DAC registers, power modes, input modes
+   (LDAC register), and the internal reference setting, updating them
+   the way each command changes the chip (see AD56X4.h). A message
+   that wouldn't change any of them is not sent, unless forced. Until
+   something has been written to a part of the state (or the chip has
+   been fully reset), that part is unknown and messages touching it
+   are always sent.
+   
+     AD56X4Device device(10);
+     AD56X4Shadow<AD56X4HardwareSPI> dac(device);
+     
+     dac.reset(true);
+     dac.setChannel(AD56X4_SETMODE_INPUT_DAC, AD56X4_CHANNEL_A, 1000);
+     dac.setChannel(AD56X4_SETMODE_INPUT_DAC, AD56X4_CHANNEL_A, 1000);
+     // Only two messages were sent.
+*/
+
+#ifndef AD56X4Shadow_h
+#define AD56X4Shadow_h
+
+#include "AD56X4Commands.h"
+
+/* Whether an AD56X4Shadow command sends its message/s only if they
+   change the chip's state, or always. It is its own type rather than
+   a boolean so that it can't be mixed up with the other arguments
+   (e.g. a channel of 0 being taken for a null values array).
+*/
+enum AD56X4Force
+{
+  AD56X4_SKIP_REDUNDANT = 0,
+  AD56X4_FORCE = 1
+};
+
+template <class Bus>
+class AD56X4Shadow
+{
+  
+  public:
+  
+    typedef typename Bus::Target Target;
+    
+    /* The chip is given by target, which must stay around as long as
+       this object (e.g. an AD56X4Device, not a Slave Select pin). Its
+       state starts out unknown.
+    */
+    AD56X4Shadow (AD56X4HeldTarget<Bus> target) : target(target)
+    {
+      forget();
+      framesSent = 0;
+      framesSuppressed = 0;
+    }
+    
+    /* Forgets the chip's state (e.g. after its power was cycled). */
+    void forget ()
+    {
+      knownInput = 0;
+      knownDAC = 0;
+      knownPower = 0;
+      knownInputModes = false;
+      knownReference = false;
+    }
+    
+    // The commands are the same as in AD56X4Commands (minus the
+    // target), with a last argument to force the message/s to be sent
+    // regardless.
+    
+    void setChannel (byte setMode, byte channel, word value,
+                     AD56X4Force force = AD56X4_SKIP_REDUNDANT)
+    {
+      if (Commands::validSetMode(setMode))
+        send(Commands::makeHeader(setMode,channel),value,force);
+    }
+    void setChannel (byte setMode, const word values[],
+                     AD56X4Force force = AD56X4_SKIP_REDUNDANT)
+    {
+      if (!Commands::validSetMode(setMode))
+        return;
+      
+      byte headers[4];
+      word data[4];
+      byte count = 0;
+      for (int i = 3; i >= 0; i--)
+        {
+          byte header = Commands::makeHeader(setMode,i);
+          if (apply(header,values[3-i],force))
+            {
+              headers[count] = header;
+              data[count] = values[3-i];
+              count++;
+            }
+        }
+      sendBurst(headers,data,count);
+    }
+    void setChannel (byte setMode, word value_D, word value_C,
+                     word value_B, word value_A,
+                     AD56X4Force force = AD56X4_SKIP_REDUNDANT)
+    {
+      word values[] = {value_D,value_C,value_B,value_A};
+      setChannel(setMode,values,force);
+    }
+    
+    /* Only the messages that change something are sent, except that
+       the last one (which updates all the DAC registers) is always
+       sent if any DAC register would change.
+    */
+    void commitChannels (const word values[],
+                         AD56X4Force force = AD56X4_SKIP_REDUNDANT)
+    {
+      word channelValues[4];
+      for (byte i = 0; i < 4; i++)
+        channelValues[i] = values[3-i];
+      byte headers[4];
+      word data[4];
+      byte made =
+        Commands::makeCommitMessages(channelValues,0x0F,
+                                     AD56X4_SETMODE_INPUT_DAC_ALL,
+                                     headers,data);
+      byte count = 0;
+      for (byte i = 0; i < made; i++)
+        if (apply(headers[i],data[i],force))
+          {
+            headers[count] = headers[i];
+            data[count] = data[i];
+            count++;
+          }
+      sendBurst(headers,data,count);
+    }
+    void commitChannels (word value_D, word value_C, word value_B,
+                         word value_A,
+                         AD56X4Force force = AD56X4_SKIP_REDUNDANT)
+    {
+      word values[] = {value_D,value_C,value_B,value_A};
+      commitChannels(values,force);
+    }
+    
+    void updateChannel (byte channel,
+                        AD56X4Force force = AD56X4_SKIP_REDUNDANT)
+    {
+      send(Commands::makeHeader(AD56X4_COMMAND_UPDATE_DAC_REGISTER,
+                                channel),0,force);
+    }
+    
+    void powerUpDown (byte powerMode, byte channelMask,
+                      AD56X4Force force = AD56X4_SKIP_REDUNDANT)
+    {
+      send(Commands::makeHeader(AD56X4_COMMAND_POWER_UPDOWN,0),
+           Commands::makePowerData(powerMode,channelMask),force);
+    }
+    void powerUpDown (byte powerMode, const boolean channels[],
+                      AD56X4Force force = AD56X4_SKIP_REDUNDANT)
+    {
+      powerUpDown(powerMode,Commands::makeChannelMask(channels),force);
+    }
+    void powerUpDown (const byte powerModes[],
+                      AD56X4Force force = AD56X4_SKIP_REDUNDANT)
+    {
+      byte headers[4];
+      word data[4];
+      byte count = 0;
+      byte header = Commands::makeHeader(AD56X4_COMMAND_POWER_UPDOWN,0);
+      for (byte i = 0; i < 4; i++)
+        {
+          word powerData = Commands::makePowerData(powerModes[i],
+                                                   1 << i);
+          if (apply(header,powerData,force))
+            {
+              headers[count] = header;
+              data[count] = powerData;
+              count++;
+            }
+        }
+      sendBurst(headers,data,count);
+    }
+    
+    /* A reset is always sent, since it is also the way to get the
+       chip into a known state.
+    */
+    void reset (boolean fullReset)
+    {
+      send(Commands::makeHeader(AD56X4_COMMAND_RESET,0),
+           (word)fullReset,AD56X4_FORCE);
+    }
+    
+    void setInputMode (byte channelMask,
+                       AD56X4Force force = AD56X4_SKIP_REDUNDANT)
+    {
+      send(Commands::makeHeader(AD56X4_COMMAND_SET_LDAC,0),
+           (word)(channelMask & 0x0F),force);
+    }
+    void setInputMode (const boolean channels[],
+                       AD56X4Force force = AD56X4_SKIP_REDUNDANT)
+    {
+      setInputMode(Commands::makeChannelMask(channels),force);
+    }
+    
+    void useInternalReference (boolean yesno,
+                               AD56X4Force force = AD56X4_SKIP_REDUNDANT)
+    {
+      send(Commands::makeHeader(AD56X4_COMMAND_REFERENCE_ONOFF,0),
+           (word)yesno,force);
+    }
+    
+    // The shadowed state. Channels are AD56X4_CHANNEL_A through
+    // AD56X4_CHANNEL_D (0 through 3) and the values are only
+    // meaningful when known.
+    
+    inline word inputRegister (byte channel) const
+    {
+      return input[channel & 3];
+    }
+    inline word dacRegister (byte channel) const
+    {
+      return dac[channel & 3];
+    }
+    inline byte powerMode (byte channel) const
+    {
+      return power[channel & 3];
+    }
+    inline byte inputModes () const
+    {
+      return inputModeMask;
+    }
+    inline boolean internalReference () const
+    {
+      return reference;
+    }
+    inline boolean known () const
+    {
+      return knownInput == 0x0F && knownDAC == 0x0F
+             && knownPower == 0x0F && knownInputModes
+             && knownReference;
+    }
+    
+    // How many messages have been sent and how many weren't because
+    // they wouldn't have changed anything.
+    
+    unsigned long framesSent;
+    unsigned long framesSuppressed;
+    
+  private:
+    
+    // Gives access to the protected helpers of the command layer.
+    
+    struct Commands : public AD56X4Commands<Bus>
+    {
+      using AD56X4Commands<Bus>::validSetMode;
+      using AD56X4Commands<Bus>::makePowerData;
+    };
+    
+    void send (byte header, word data, AD56X4Force force)
+    {
+      if (apply(header,data,force))
+        {
+          Bus::writeMessage(target,header,data);
+          framesSent++;
+        }
+    }
+    
+    void sendBurst (const byte headers[], const word data[],
+                    byte count)
+    {
+      if (count > 0)
+        Bus::writeMessages(target,headers,data,count);
+      framesSent += count;
+    }
+    
+    /* Updates the shadows for the message made of header and data
+       and returns whether it should be sent, which is if it is forced
+       or it changes (or might change) the chip's state. Suppressed
+       messages are counted here.
+    */
+    boolean apply (byte header, word data, AD56X4Force force)
+    {
+      
+      byte command = header & 0x38;
+      byte address = header & 0x07;
+      
+      // The channels addressed (bit i for channel i).
+      
+      byte channels = (address == AD56X4_CHANNEL_ALL) ? 0x0F
+                      : ((address < 4) ? (1 << address) : 0);
+      
+      boolean changed = false;
+      
+      switch (command)
+        {
+          
+        case AD56X4_COMMAND_WRITE_INPUT_REGISTER:
+          
+          for (byte i = 0; i < 4; i++)
+            if (channels & (1 << i))
+              {
+                changed |= setInput(i,data);
+                
+                // The DAC register follows if the channel's input mode
+                // (LDAC) says so. If that isn't known, it keeps being
+                // known only if it already matches.
+                
+                if (knownInputModes)
+                  {
+                    if (inputModeMask & (1 << i))
+                      changed |= updateDAC(i);
+                  }
+                else if (!(knownDAC & (1 << i)) || dac[i] != data)
+                  {
+                    knownDAC &= ~(1 << i);
+                    changed = true;
+                  }
+              }
+          break;
+          
+        case AD56X4_COMMAND_WRITE_UPDATE_CHANNEL:
+          
+          for (byte i = 0; i < 4; i++)
+            if (channels & (1 << i))
+              {
+                changed |= setInput(i,data);
+                changed |= updateDAC(i);
+              }
+          break;
+          
+        case AD56X4_COMMAND_WRITE_INPUT_REGISTER_UPDATE_ALL:
+          
+          for (byte i = 0; i < 4; i++)
+            if (channels & (1 << i))
+              changed |= setInput(i,data);
+          for (byte i = 0; i < 4; i++)
+            changed |= updateDAC(i);
+          break;
+          
+        case AD56X4_COMMAND_UPDATE_DAC_REGISTER:
+          
+          for (byte i = 0; i < 4; i++)
+            if (channels & (1 << i))
+              changed |= updateDAC(i);
+          break;
+          
+        case AD56X4_COMMAND_POWER_UPDOWN:
+          
+          for (byte i = 0; i < 4; i++)
+            if (data & (1 << i))
+              {
+                byte mode = data & 0x30;
+                if (!(knownPower & (1 << i)) || power[i] != mode)
+                  changed = true;
+                power[i] = mode;
+                knownPower |= 1 << i;
+              }
+          break;
+          
+        case AD56X4_COMMAND_RESET:
+          
+          for (byte i = 0; i < 4; i++)
+            {
+              input[i] = 0;
+              dac[i] = 0;
+            }
+          knownInput = 0x0F;
+          knownDAC = 0x0F;
+          if (data & 1)
+            {
+              for (byte i = 0; i < 4; i++)
+                power[i] = AD56X4_POWERMODE_NORMAL;
+              knownPower = 0x0F;
+              inputModeMask = 0;
+              knownInputModes = true;
+              reference = false;
+              knownReference = true;
+            }
+          changed = true;
+          break;
+          
+        case AD56X4_COMMAND_SET_LDAC:
+          
+          changed = !knownInputModes
+                    || inputModeMask != (byte)(data & 0x0F);
+          inputModeMask = data & 0x0F;
+          knownInputModes = true;
+          break;
+          
+        case AD56X4_COMMAND_REFERENCE_ONOFF:
+          
+          changed = !knownReference || reference != (boolean)(data & 1);
+          reference = data & 1;
+          knownReference = true;
+          break;
+          
+        }
+      
+      if (changed || force == AD56X4_FORCE)
+        return true;
+      framesSuppressed++;
+      return false;
+      
+    }
+    
+    // Set the input register of channel i, and copy the input
+    // register of channel i to its DAC register. Each returns whether
+    // that changed (or might have changed) anything.
+    
+    boolean setInput (byte i, word value)
+    {
+      boolean changed = !(knownInput & (1 << i)) || input[i] != value;
+      input[i] = value;
+      knownInput |= 1 << i;
+      return changed;
+    }
+    boolean updateDAC (byte i)
+    {
+      if (!(knownInput & (1 << i)))
+        {
+          knownDAC &= ~(1 << i);
+          return true;
+        }
+      boolean changed = !(knownDAC & (1 << i)) || dac[i] != input[i];
+      dac[i] = input[i];
+      knownDAC |= 1 << i;
+      return changed;
+    }
+    
+    Target target;
+    
+    word input[4];
+    word dac[4];
+    byte power[4];
+    byte inputModeMask;
+    boolean reference;
+    
+    // Which parts of the state are known (bit i for channel i).
+    
+    byte knownInput;
+    byte knownDAC;
+    byte knownPower;
+    boolean knownInputModes;
+    boolean knownReference;
+    
+};
+
+#endif
@@ -0,0 +1,247 @@
+/* Copyright (c) 2026, Freja Nordsiek
+   All rights reserved.
+   
+   Redistribution and use in source and binary forms, with or
+   without modification, are permitted provided that the
+   following conditions are met:
+   
+   1. Redistributions of source code must retain the above
+   copyright notice, this list of conditions and the following disclaimer.
+   
+   2. Redistributions in binary form must reproduce the above
+   copyright notice, this list of conditions and the following
+   disclaimer in the documentation and/or other materials
+   provided with the distribution.
+   
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+   NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+   LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+   HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+   OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*
+   AD56X4SoftSPI.h: Software (bit-banged) SPI bus for the AD56X4
+                    library with the pins fixed at compile time.
+   
+   Author:   Freja Nordsiek
+   Notes:
+   History:  * 2026-10-16 Created.
+*/
+
+/* For boards whose hardware SPI pins are taken by other devices, the
+   chip can be driven on any three pins by bit-banging. The pins are
+   template parameters so that, on the ATmega328P/168 (Uno and
+   friends) and ATmega1280/2560 (Mega), their port registers and bit
+   masks are known at compile time and each pin change is a single
+   instruction (sbi/cbi for ports in the I/O space). This gives a bit
+   rate of a couple of Mbit/s at 16 MHz. On other boards, the pins
+   are driven with digitalWrite, which is a lot slower but works.
+   
+   The timing is the same SPI_MODE1 the hardware SPI bus uses: SCK
+   idles low, each bit is put on MOSI after the rising edge of SCK,
+   and the chip reads it on the falling edge. Bits are sent MSB
+   first. Interrupts are held off while each message is sent.
+   
+     typedef AD56X4SoftSPI<4, 5, 6> DACBus;   // MOSI, SCK, SYNC
+     DACBus dacBus;
+     
+     DACBus::begin();
+     AD56X4Commands<DACBus>::reset(dacBus, true);
+*/
+
+#ifndef AD56X4SoftSPI_h
+#define AD56X4SoftSPI_h
+
+#include "Arduino.h"
+#include "AD56X4.h"
+
+#if defined(__AVR_ATmega2560__) || defined(__AVR_ATmega1280__)
+
+/* The Mega's pins are spread all over the ports, so these give the
+   port output register (data memory address) and bit of each pin
+   (the same as the tables in the Mega's pins_arduino.h). The ports
+   are A 0x22, B 0x25, C 0x28, D 0x2B, E 0x2E, F 0x31, G 0x34,
+   H 0x102, J 0x105, K 0x108, and L 0x10B.
+*/
+
+constexpr uint16_t AD56X4MegaPinPort (uint8_t p)
+{
+  return (p <= 3) ? 0x2E : (p == 4) ? 0x34 : (p == 5) ? 0x2E
+         : (p <= 9) ? 0x102 : (p <= 13) ? 0x25 : (p <= 15) ? 0x105
+         : (p <= 17) ? 0x102 : (p <= 21) ? 0x2B : (p <= 29) ? 0x22
+         : (p <= 37) ? 0x28 : (p == 38) ? 0x2B : (p <= 41) ? 0x34
+         : (p <= 49) ? 0x10B : (p <= 53) ? 0x25 : (p <= 61) ? 0x31
+         : 0x108;
+}
+constexpr uint8_t AD56X4MegaPinBit (uint8_t p)
+{
+  return (p <= 1) ? p : (p <= 3) ? p + 2 : (p == 4) ? 5
+         : (p == 5) ? 3 : (p <= 9) ? p - 3 : (p <= 13) ? p - 6
+         : (p == 14) ? 1 : (p == 15) ? 0 : (p == 16) ? 1
+         : (p == 17) ? 0 : (p <= 21) ? 21 - p : (p <= 29) ? p - 22
+         : (p <= 37) ? 37 - p : (p == 38) ? 7 : (p <= 41) ? 41 - p
+         : (p <= 49) ? 49 - p : (p <= 53) ? 53 - p
+         : (p <= 61) ? p - 54 : (p <= 69) ? p - 62 : 0;
+}
+
+#endif
+
+/* Port output register (data memory address) and bit mask of an
+   Arduino pin, when known at compile time for the board being
+   compiled for. known is false for pins (or boards) it doesn't
+   know, in which case digitalWrite must be used instead.
+*/
+template <uint8_t pin>
+struct AD56X4FastPin
+{
+  
+#if defined(__AVR_ATmega328P__) || defined(__AVR_ATmega168__) \
+    || defined(__AVR_ATmega328__) || defined(__AVR_ATmega168P__)
+  
+  // Pins 0-7 are PORTD, 8-13 are PORTB, and 14-19 (A0-A5) are
+  // PORTC.
+  
+  static const boolean known = (pin < 20);
+  static const uint16_t port = (pin < 8) ? 0x2B
+                               : ((pin < 14) ? 0x25 : 0x28);
+  static const uint8_t mask = 1 << ((pin < 8) ? pin
+                                    : ((pin < 14) ? pin - 8
+                                       : pin - 14));
+  
+#elif defined(__AVR_ATmega2560__) || defined(__AVR_ATmega1280__)
+  
+  static const boolean known = (pin < 70);
+  static const uint16_t port = AD56X4MegaPinPort(pin);
+  static const uint8_t mask = 1 << AD56X4MegaPinBit(pin);
+  
+#else
+  
+  static const boolean known = false;
+  static const uint16_t port = 0;
+  static const uint8_t mask = 0;
+  
+#endif
+  
+  static inline void high ()
+  {
+#if defined(__AVR__)
+    if (known)
+      {
+        _SFR_MEM8(port) |= mask;
+        return;
+      }
+#endif
+    digitalWrite(pin,HIGH);
+  }
+  static inline void low ()
+  {
+#if defined(__AVR__)
+    if (known)
+      {
+        _SFR_MEM8(port) &= ~mask;
+        return;
+      }
+#endif
+    digitalWrite(pin,LOW);
+  }
+  
+};
+
+
+
+/* Bus policy (see AD56X4Commands.h) bit-banging SPI on the pins
+   MOSI_pin, SCK_pin, and SS_pin (the chip's DIN, SCLK, and SYNC).
+   The Target is the bus object itself, which holds nothing.
+*/
+template <uint8_t MOSI_pin, uint8_t SCK_pin, uint8_t SS_pin>
+class AD56X4SoftSPI
+{
+  
+  public:
+  
+    typedef const AD56X4SoftSPI &Target;
+    
+    /* Sets the pins to outputs with the Slave Select pin high (not
+       selected) and SCK low (idle).
+    */
+    static void begin ()
+    {
+      SYNC::high();
+      SCK::low();
+      pinMode(SS_pin,OUTPUT);
+      pinMode(SCK_pin,OUTPUT);
+      pinMode(MOSI_pin,OUTPUT);
+    }
+    
+    static inline void writeMessage (Target, byte header, word data)
+    {
+#if defined(__AVR__)
+      uint8_t oldSREG = SREG;
+      cli();
+#endif
+      sendMessage(header,data);
+#if defined(__AVR__)
+      SREG = oldSREG;
+#endif
+    }
+    static inline void writeMessages (Target, const byte headers[],
+                                      const word data[], byte count)
+    {
+      for (byte i = 0; i < count; i++)
+        {
+#if defined(__AVR__)
+          uint8_t oldSREG = SREG;
+          cli();
+#endif
+          sendMessage(headers[i],data[i]);
+#if defined(__AVR__)
+          SREG = oldSREG;
+#endif
+        }
+    }
+    
+  private:
+    typedef AD56X4FastPin<MOSI_pin> MOSI;
+    typedef AD56X4FastPin<SCK_pin> SCK;
+    typedef AD56X4FastPin<SS_pin> SYNC;
+    
+    static inline void sendMessage (byte header, word data)
+    {
+      AD56X4_TRACE_SYNC(LOW);
+      SYNC::low();
+      sendByte(header);
+      sendByte(highByte(data));
+      sendByte(lowByte(data));
+      AD56X4_TRACE_SYNC(HIGH);
+      SYNC::high();
+    }
+    
+    // Shifts out one byte MSB first. Each bit goes on MOSI after the
+    // rising edge of SCK, and the chip reads it on the falling edge.
+    
+    static inline void sendByte (byte value)
+    {
+      AD56X4_TRACE_BYTE(value);
+      for (byte bit = 0x80; bit != 0; bit >>= 1)
+        {
+          SCK::high();
+          if (value & bit)
+            MOSI::high();
+          else
+            MOSI::low();
+          SCK::low();
+        }
+    }
+    
+};
+
+#endif
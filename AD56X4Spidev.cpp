@@ -0,0 +1,195 @@
+/* Copyright (c) 2026, Freja Nordsiek
+   All rights reserved.
+   
+   Redistribution and use in source and binary forms, with or
+   without modification, are permitted provided that the
+   following conditions are met:
+   
+   1. Redistributions of source code must retain the above
+   copyright notice, this list of conditions and the following disclaimer.
+   
+   2. Redistributions in binary form must reproduce the above
+   copyright notice, this list of conditions and the following
+   disclaimer in the documentation and/or other materials
+   provided with the distribution.
+   
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+   NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+   LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+   HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+   OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*
+   AD56X4Spidev.cpp: Linux spidev bus for the AD56X4 library.
+   
+   Author:   Freja Nordsiek
+   Notes:    Only compiled on Linux.
+   History:  * 2026-10-16 Created.
+*/
+
+#if defined(__linux__)
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include "AD56X4Spidev.h"
+
+AD56X4Spidev::AD56X4Spidev ()
+{
+  fd = -1;
+  speed = 0;
+  batching = false;
+  lastError = 0;
+  count = 0;
+}
+
+AD56X4Spidev::~AD56X4Spidev ()
+{
+  close();
+}
+
+/* Opens the spidev device at path (e.g. "/dev/spidev0.0") and sets
+   it up for the chip, which is SPI_MODE_1, MSB first, 8 bits per
+   word, and a clock of speed Hz (the chip can go up to 50 MHz).
+   Returns whether it succeeded (error gives the errno if not).
+*/
+boolean AD56X4Spidev::open (const char *path, uint32_t speed)
+{
+  close();
+  
+  fd = ::open(path,O_RDWR);
+  if (fd < 0)
+    {
+      lastError = errno;
+      return false;
+    }
+  
+  uint8_t mode = SPI_MODE_1;
+  uint8_t lsbFirst = 0;
+  uint8_t bits = 8;
+  
+  if (ioctl(fd,SPI_IOC_WR_MODE,&mode) < 0
+      || ioctl(fd,SPI_IOC_WR_LSB_FIRST,&lsbFirst) < 0
+      || ioctl(fd,SPI_IOC_WR_BITS_PER_WORD,&bits) < 0
+      || ioctl(fd,SPI_IOC_WR_MAX_SPEED_HZ,&speed) < 0)
+    {
+      lastError = errno;
+      ::close(fd);
+      fd = -1;
+      return false;
+    }
+  
+  this->speed = speed;
+  return true;
+}
+
+/* Sends any collected messages and closes the device. */
+void AD56X4Spidev::close ()
+{
+  if (fd < 0)
+    return;
+  
+  flush();
+  ::close(fd);
+  fd = -1;
+  batching = false;
+}
+
+/* Starts collecting messages instead of sending them right away. */
+void AD56X4Spidev::beginBatch ()
+{
+  batching = true;
+}
+
+/* Sends the collected messages and stops collecting them. Returns
+   whether the sending succeeded.
+*/
+boolean AD56X4Spidev::endBatch ()
+{
+  batching = false;
+  return flush();
+}
+
+/* Sends all the collected messages in one ioctl. Returns whether it
+   succeeded (error gives the errno if not). The messages are dropped
+   either way.
+*/
+boolean AD56X4Spidev::flush ()
+{
+  if (count == 0)
+    return true;
+  
+  // The chip select goes high between messages but not after the
+  // last one, as it goes high at the end of the whole SPI message
+  // anyways.
+  
+  transfers[count - 1].cs_change = 0;
+  
+  int result = -1;
+  if (fd >= 0)
+    result = ioctl(fd,SPI_IOC_MESSAGE(count),transfers);
+  else
+    errno = EBADF;
+  
+  count = 0;
+  
+  if (result < 0)
+    {
+      lastError = errno;
+      return false;
+    }
+  return true;
+}
+
+/* Collects one message, sending the collected ones first if there
+   is no more room.
+*/
+void AD56X4Spidev::add (byte header, word data)
+{
+  if (count == AD56X4_SPIDEV_BATCH)
+    flush();
+  
+  uint8_t *bytes = buffer[count];
+  bytes[0] = header;
+  bytes[1] = (uint8_t)(data >> 8);
+  bytes[2] = (uint8_t)(data & 0xFF);
+  
+  struct spi_ioc_transfer &transfer = transfers[count];
+  memset(&transfer,0,sizeof(transfer));
+  transfer.tx_buf = (unsigned long)bytes;
+  transfer.len = 3;
+  transfer.speed_hz = speed;
+  transfer.bits_per_word = 8;
+  transfer.cs_change = 1;
+  
+  count++;
+}
+
+void AD56X4Spidev::writeMessage (Target bus, byte header, word data)
+{
+  bus.add(header,data);
+  if (!bus.batching)
+    bus.flush();
+}
+
+void AD56X4Spidev::writeMessages (Target bus, const byte headers[],
+                                  const word data[], byte count)
+{
+  for (byte i = 0; i < count; i++)
+    bus.add(headers[i],data[i]);
+  if (!bus.batching)
+    bus.flush();
+}
+
+#endif
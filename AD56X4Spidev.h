@@ -0,0 +1,149 @@
+/* Copyright (c) 2026, Freja Nordsiek
+   All rights reserved.
+   
+   Redistribution and use in source and binary forms, with or
+   without modification, are permitted provided that the
+   following conditions are met:
+   
+   1. Redistributions of source code must retain the above
+   copyright notice, this list of conditions and the following disclaimer.
+   
+   2. Redistributions in binary form must reproduce the above
+   copyright notice, this list of conditions and the following
+   disclaimer in the documentation and/or other materials
+   provided with the distribution.
+   
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+   NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+   LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+   HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+   OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*
+   AD56X4Spidev.h: Linux spidev bus for the AD56X4 library, for
+                   driving the chips from an embedded Linux host.
+   
+   Author:   Freja Nordsiek
+   Notes:    Only available on Linux. Doesn't need Arduino.h.
+   History:  * 2026-10-16 Created.
+*/
+
+/* Each message is one spi_ioc_transfer of 3 bytes, with cs_change
+   set on all but the last transfer of an SPI_IOC_MESSAGE so that the
+   chip select (SYNC) goes high between messages. A burst of messages
+   (e.g. the four of setChannel with an array of values) always goes
+   out in a single ioctl. Between beginBatch and endBatch (or flush),
+   messages are not sent right away but collected (up to
+   AD56X4_SPIDEV_BATCH of them, after which they are sent) so that a
+   whole refresh or block of waveform samples goes out in a single
+   ioctl too.
+   
+     AD56X4Spidev dac;
+     
+     if (!dac.open("/dev/spidev0.0"))
+       ... dac.error() has the errno ...
+     
+     typedef AD56X4Commands<AD56X4Spidev> DAC;
+     
+     dac.beginBatch();
+     DAC::setChannel(dac, AD56X4_SETMODE_INPUT, values);
+     DAC::updateChannel(dac, AD56X4_CHANNEL_ALL);
+     dac.endBatch();
+*/
+
+#ifndef AD56X4Spidev_h
+#define AD56X4Spidev_h
+
+#if defined(__linux__)
+
+#include <stdint.h>
+#include <linux/spi/spidev.h>
+#include "AD56X4Commands.h"
+
+/* The most messages collected before they are sent. It can be
+   changed by defining it before this header is included and when
+   compiling the library. All of them go in one SPI_IOC_MESSAGE,
+   whose size (of the transfers) has to fit in the 14 bit size field
+   of an ioctl request (SPI_IOC_MESSAGE quietly becomes a zero size
+   request otherwise), which is 511 transfers.
+*/
+
+#ifndef AD56X4_SPIDEV_BATCH
+#define AD56X4_SPIDEV_BATCH 64
+#endif
+
+#if AD56X4_SPIDEV_BATCH < 1
+#error "AD56X4_SPIDEV_BATCH must be at least 1"
+#endif
+
+static_assert(AD56X4_SPIDEV_BATCH * sizeof(struct spi_ioc_transfer)
+              < (1 << _IOC_SIZEBITS),
+              "AD56X4_SPIDEV_BATCH transfers don't fit in one "
+              "SPI_IOC_MESSAGE");
+
+/* Bus policy (see AD56X4Commands.h) on a Linux spidev device. The
+   Target is the bus object. It owns the open device, so it can't be
+   copied (the copy would close it too).
+*/
+class AD56X4Spidev
+{
+  
+  public:
+  
+    typedef AD56X4Spidev &Target;
+    
+    AD56X4Spidev ();
+    ~AD56X4Spidev ();
+    
+    AD56X4Spidev (const AD56X4Spidev &) = delete;
+    AD56X4Spidev &operator= (const AD56X4Spidev &) = delete;
+    
+    boolean open (const char *path, uint32_t speed = 10000000);
+    void close ();
+    
+    void beginBatch ();
+    boolean endBatch ();
+    boolean flush ();
+    
+    /* Number of messages collected and not sent yet. */
+    inline unsigned int pending () const
+    {
+      return count;
+    }
+    
+    /* errno of the last thing that failed (0 if nothing has). */
+    inline int error () const
+    {
+      return lastError;
+    }
+    
+    static void writeMessage (Target bus, byte header, word data);
+    static void writeMessages (Target bus, const byte headers[],
+                               const word data[], byte count);
+    
+  private:
+    void add (byte header, word data);
+    
+    int fd;
+    uint32_t speed;
+    boolean batching;
+    int lastError;
+    
+    unsigned int count;
+    struct spi_ioc_transfer transfers[AD56X4_SPIDEV_BATCH];
+    uint8_t buffer[AD56X4_SPIDEV_BATCH][3];
+    
+};
+
+#endif
+
+#endif
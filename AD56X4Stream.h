@@ -0,0 +1,492 @@
+/* Copyright (c) 2026, Freja Nordsiek
+   All rights reserved.
+   
+   Redistribution and use in source and binary forms, with or
+   without modification, are permitted provided that the
+   following conditions are met:
+   
+   1. Redistributions of source code must retain the above
+   copyright notice, this list of conditions and the following disclaimer.
+   
+   2. Redistributions in binary form must reproduce the above
+   copyright notice, this list of conditions and the following
+   disclaimer in the documentation and/or other materials
+   provided with the distribution.
+   
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+   NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+   LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+   HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+   OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*
+   AD56X4Stream.h: Receiver of samples streamed to an AD56X4 over a
+                   serial port in a compact binary protocol.
+   
+   Author:   Freja Nordsiek
+   Notes:    The reference sender for a PC is host/streamsend.cpp.
+   History:  * 2026-10-16 Created.
+*/
+
+/* Streaming samples from a PC as text commands, one setChannel per
+   value, manages a few hundred samples a second. An
+   AD56X4StreamReceiver instead takes them in a binary protocol on a
+   serial port (anything with available, read, and write like
+   Serial), parsing the bytes straight into a ring of samples which
+   the output path (usually a sample clock producer) drains at a
+   fixed rate. The PC sends
+   
+     Samples:  AD56X4_STREAM_SYNC, n, n samples, checksum
+     Reset:    AD56X4_STREAM_SYNC, 0, 0
+   
+   where each sample is the four channel values in channel D to A
+   order, each low byte first (8 bytes), and the checksum makes the
+   sum of n, the samples, and itself zero (mod 256). A block's
+   samples only go in the ring once its checksum is good, so the
+   output never sees half a block. The receiver sends back
+   
+     Credit:     AD56X4_STREAM_CREDIT, n
+     Reset ack:  AD56X4_STREAM_RESET_ACK, n
+     Resync:     AD56X4_STREAM_RESYNC, 0
+   
+   Flow control is by credit: the PC may only have as many samples
+   sent but not yet drained as it has been given credit for. A reset
+   empties the ring and is acknowledged with the whole ring as
+   credit, and afterwards credit is given back as samples are
+   drained, a quarter of the ring at a time or whenever the ring
+   runs empty. When the ring is empty, the output repeats the last
+   sample and the underrun is counted (only after the first block
+   since the reset, so waiting for the PC doesn't count).
+   
+   How many samples were sent in a block that went wrong can't be
+   known (its count may be what was corrupted, or its sync byte lost
+   so the whole block was skipped), so no credit is given back for
+   one. Instead, a bad checksum, a byte other than the sync byte
+   where a block should start, or a block stopping partway through
+   for AD56X4_STREAM_TIMEOUT ms is counted as an error, and the PC is
+   asked to resync. The PC answers with a reset, which (while a
+   resync is asked for) keeps the ring and is acknowledged with the
+   room left in it, so that the credit is right again. Blocks that
+   arrive in the meantime are taken as usual. The PC is also asked to
+   resync (without an error being counted) when the ring has run
+   empty and nothing has arrived for AD56X4_STREAM_TIMEOUT ms, since
+   that is what the PC waiting on credit lost with a block looks
+   like.
+   
+     AD56X4StreamReceiver<HardwareSerial> stream(Serial);
+     
+     void nextSample (word values[])
+     {
+       stream.next(values);
+     }
+     
+     void loop ()
+     {
+       stream.poll();
+     }
+   
+   poll must be called often enough to keep up with the serial port
+   (a ring of 32 samples at 5 kHz empties in 6 ms). A block can be as
+   long as 255 samples, but blocks no longer than a quarter of the
+   ring keep it fullest.
+*/
+
+#ifndef AD56X4Stream_h
+#define AD56X4Stream_h
+
+#include "Arduino.h"
+
+// The number of samples in the ring. It must be a power of two no
+// bigger than 128. Each takes 8 bytes of RAM.
+
+#ifndef AD56X4_STREAM_LENGTH
+#define AD56X4_STREAM_LENGTH 32
+#endif
+
+#if (AD56X4_STREAM_LENGTH & (AD56X4_STREAM_LENGTH - 1)) != 0 \
+    || AD56X4_STREAM_LENGTH > 128
+#error "AD56X4_STREAM_LENGTH must be a power of two no bigger than 128"
+#endif
+
+// How long in ms nothing arriving means something was lost (see
+// above). It must be well more than a byte takes at the baud rate.
+
+#ifndef AD56X4_STREAM_TIMEOUT
+#define AD56X4_STREAM_TIMEOUT 50
+#endif
+
+// The first byte of every message, each way.
+
+#define AD56X4_STREAM_SYNC 0xA5
+#define AD56X4_STREAM_CREDIT 0x5A
+#define AD56X4_STREAM_RESET_ACK 0x5B
+#define AD56X4_STREAM_RESYNC 0x5C
+
+template <class Port>
+class AD56X4StreamReceiver
+{
+  
+  public:
+  
+    /* port must stay around as long as the receiver. Nothing is
+       sent until the PC resets the stream.
+    */
+    AD56X4StreamReceiver (Port &port) : port(port)
+    {
+      for (byte i = 0; i < 4; i++)
+        last[i] = 0;
+      head = 0;
+      tail = 0;
+      state = WAIT_SYNC;
+      empty();
+      clearStatistics();
+      lastArrival = millis();
+      
+      // Until the first reset, the PC isn't there to ask for one, and
+      // whatever arrives before it is ignored.
+      
+      resyncing = true;
+    }
+    
+    /* Reads and parses what has arrived on the port (up to 64 bytes
+       at a time, so that credit keeps going back while a lot is
+       arriving), gives credit back for drained samples, and asks the
+       PC to resync if nothing has arrived for too long (see above).
+    */
+    void poll ()
+    {
+      
+      byte n = 0;
+      while (n < 64 && port.available() > 0)
+        {
+          receive((byte)port.read());
+          n++;
+        }
+      
+      if (n != 0)
+        lastArrival = millis();
+      else if (millis() - lastArrival >= AD56X4_STREAM_TIMEOUT)
+        {
+          if (state != WAIT_SYNC)
+            {
+              state = WAIT_SYNC;
+              error();
+            }
+          else if (started && head == tail && !resyncing)
+            askResync();
+        }
+      
+      // Collect the samples drained since last time.
+      
+#if defined(__AVR__)
+      uint8_t oldSREG = SREG;
+      cli();
+#endif
+      credit += drained;
+      drained = 0;
+#if defined(__AVR__)
+      SREG = oldSREG;
+#endif
+      
+      if (credit >= AD56X4_STREAM_LENGTH / 4
+          || (credit != 0 && head == tail))
+        sendCredit(AD56X4_STREAM_CREDIT);
+      
+    }
+    
+    /* Takes the next sample (channel D to A order) out of the ring,
+       for the output path (it may be called from an interrupt).
+       Returns whether there was one. If not, values is set to the
+       last sample again.
+    */
+    boolean next (word values[])
+    {
+      
+      byte t = tail;
+      
+      if (t == head)
+        {
+          if (started)
+            underrunCount++;
+          for (byte i = 0; i < 4; i++)
+            values[i] = last[i];
+          return false;
+        }
+      
+      const word *sample = ring[t & MASK];
+      for (byte i = 0; i < 4; i++)
+        values[i] = last[i] = sample[i];
+      
+      tail = t + 1;
+      drained++;
+      return true;
+      
+    }
+    
+    /* The number of samples in the ring. */
+    inline byte available () const
+    {
+      return head - tail;
+    }
+    
+    /* Statistics since construction or clearStatistics: the samples
+       put in the ring, the times the output found it empty, the
+       errors (see above, counting once until the PC resyncs), and the
+       samples dropped for not fitting in the ring (the PC sending
+       more than its credit).
+    */
+    inline unsigned long received () const
+    {
+      return receivedCount;
+    }
+    unsigned long underruns () const
+    {
+#if defined(__AVR__)
+      uint8_t oldSREG = SREG;
+      cli();
+      unsigned long count = underrunCount;
+      SREG = oldSREG;
+      return count;
+#else
+      return underrunCount;
+#endif
+    }
+    inline unsigned long errors () const
+    {
+      return errorCount;
+    }
+    inline unsigned long overflows () const
+    {
+      return overflowCount;
+    }
+    void clearStatistics ()
+    {
+      receivedCount = 0;
+      errorCount = 0;
+      overflowCount = 0;
+#if defined(__AVR__)
+      uint8_t oldSREG = SREG;
+      cli();
+#endif
+      underrunCount = 0;
+#if defined(__AVR__)
+      SREG = oldSREG;
+#endif
+    }
+    
+  private:
+    
+    enum State
+    {
+      WAIT_SYNC,
+      WAIT_COUNT,
+      WAIT_DATA,
+      WAIT_CHECKSUM
+    };
+    
+    static const byte MASK = AD56X4_STREAM_LENGTH - 1;
+    
+    /* Empties the ring and forgets the credit given. */
+    void empty ()
+    {
+#if defined(__AVR__)
+      uint8_t oldSREG = SREG;
+      cli();
+#endif
+      head = tail;
+      drained = 0;
+      started = false;
+#if defined(__AVR__)
+      SREG = oldSREG;
+#endif
+      credit = 0;
+    }
+    
+    /* Sends the credit owed (at most 255 at a time) in messages
+       starting with type. A reset is acknowledged even with no
+       credit.
+    */
+    void sendCredit (byte type)
+    {
+      while (credit != 0 || type == AD56X4_STREAM_RESET_ACK)
+        {
+          byte n = credit > 255 ? 255 : credit;
+          port.write(type);
+          port.write(n);
+          credit -= n;
+          type = AD56X4_STREAM_CREDIT;
+        }
+    }
+    
+    /* Asks the PC to resync, after which nothing more is asked or
+       counted as an error until it does.
+    */
+    void askResync ()
+    {
+      resyncing = true;
+      port.write(AD56X4_STREAM_RESYNC);
+      port.write((byte)0);
+    }
+    void error ()
+    {
+      if (resyncing)
+        return;
+      errorCount++;
+      askResync();
+    }
+    
+    /* Acknowledges a reset the PC sent to resync: the ring is kept,
+       and the room left in it is the credit (the samples drained but
+       not yet given back are part of that room).
+    */
+    void resync ()
+    {
+#if defined(__AVR__)
+      uint8_t oldSREG = SREG;
+      cli();
+#endif
+      credit = AD56X4_STREAM_LENGTH - (byte)(head - tail);
+      drained = 0;
+      started = false;
+#if defined(__AVR__)
+      SREG = oldSREG;
+#endif
+      sendCredit(AD56X4_STREAM_RESET_ACK);
+    }
+    
+    /* Parses one byte. The samples of a block are written straight
+       into the ring past head (where the output doesn't look), and
+       only become part of it when head is moved past them once the
+       checksum is good.
+    */
+    void receive (byte value)
+    {
+      
+      switch (state)
+        {
+          
+          case WAIT_SYNC:
+            if (value == AD56X4_STREAM_SYNC)
+              state = WAIT_COUNT;
+            else
+              error();
+            break;
+            
+          case WAIT_COUNT:
+            remaining = value;
+            blockLength = value;
+            sum = value;
+            staged = 0;
+            byteIndex = 0;
+            state = value != 0 ? WAIT_DATA : WAIT_CHECKSUM;
+            break;
+            
+          case WAIT_DATA:
+            {
+              
+              sum += value;
+              
+              byte slot = head + staged;
+              boolean room = (byte)(slot - tail) < AD56X4_STREAM_LENGTH;
+              
+              if (byteIndex & 1)
+                {
+                  if (room)
+                    ring[slot & MASK][byteIndex >> 1] = (value << 8)
+                                                        | lowValue;
+                }
+              else
+                lowValue = value;
+              
+              if (++byteIndex == 8)
+                {
+                  byteIndex = 0;
+                  if (room)
+                    staged++;
+                  if (--remaining == 0)
+                    state = WAIT_CHECKSUM;
+                }
+              
+              break;
+              
+            }
+            
+          case WAIT_CHECKSUM:
+            
+            state = WAIT_SYNC;
+            
+            if ((byte)(sum + value) != 0)
+              error();
+            else if (blockLength == 0 && resyncing)
+              {
+                resyncing = false;
+                resync();
+              }
+            else if (blockLength == 0)
+              {
+                empty();
+                credit = AD56X4_STREAM_LENGTH;
+                sendCredit(AD56X4_STREAM_RESET_ACK);
+              }
+            else
+              {
+                head += staged;
+                started = true;
+                receivedCount += staged;
+                overflowCount += blockLength - staged;
+              }
+            
+            break;
+            
+        }
+      
+    }
+    
+    Port &port;
+    
+    // The ring. head is written only by poll and tail only by next.
+    
+    word ring[AD56X4_STREAM_LENGTH][4];
+    volatile byte head;
+    volatile byte tail;
+    word last[4];
+    volatile boolean started;
+    
+    // Samples drained by next not yet added to the credit owed.
+    
+    volatile byte drained;
+    word credit;
+    
+    // Whether the PC has been asked to resync (or hasn't reset the
+    // stream yet), and when something last arrived.
+    
+    boolean resyncing;
+    unsigned long lastArrival;
+    
+    // Parser state.
+    
+    State state;
+    byte blockLength;
+    byte remaining;
+    byte staged;
+    byte byteIndex;
+    byte lowValue;
+    byte sum;
+    
+    unsigned long receivedCount;
+    volatile unsigned long underrunCount;
+    unsigned long errorCount;
+    unsigned long overflowCount;
+    
+};
+
+#endif
@@ -0,0 +1,254 @@
+/* Copyright (c) 2026, Freja Nordsiek
+   All rights reserved.
+   
+   Redistribution and use in source and binary forms, with or
+   without modification, are permitted provided that the
+   following conditions are met:
+   
+   1. Redistributions of source code must retain the above
+   copyright notice, this list of conditions and the following disclaimer.
+   
+   2. Redistributions in binary form must reproduce the above
+   copyright notice, this list of conditions and the following
+   disclaimer in the documentation and/or other materials
+   provided with the distribution.
+   
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+   NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+   LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+   HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+   OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*
+   AD56X4Typed.h: AD56X4 commands taking strongly typed set modes,
+                  channels, and power modes.
+   
+   Author:   Freja Nordsiek
+   Notes:    Doesn't need Arduino.h. Needs C++11 (enum class and
+             constexpr).
+   History:  * 2026-10-16 Created.
+*/
+
+/* The commands in AD56X4Commands take the set mode, channel, and
+   power mode as bytes, so they have to check the set mode and mask
+   every field on every call, and a power mode given where a set mode
+   goes still compiles. Here they are enum classes instead
+   (AD56X4SetMode, AD56X4Channel, and AD56X4PowerMode, with
+   AD56X4ChannelMask for sets of channels made by or'ing channels),
+   which can only hold valid values and can't be mixed up, so giving
+   the wrong kind of thing fails to compile and there is nothing left
+   to check or mask. The headers are worked out by constexpr
+   functions, and giving the set mode and channel as template
+   arguments makes the header a constant.
+   
+     typedef AD56X4TypedCommands<AD56X4HardwareSPI> DAC;
+     
+     DAC::setChannel<AD56X4SetMode::InputDAC, AD56X4Channel::A>(device,
+                                                                value);
+     DAC::powerUpDown(device, AD56X4PowerMode::TriState,
+                      AD56X4Channel::C | AD56X4Channel::D);
+*/
+
+#ifndef AD56X4Typed_h
+#define AD56X4Typed_h
+
+#include "AD56X4Commands.h"
+
+enum class AD56X4SetMode : byte
+{
+  Input = AD56X4_SETMODE_INPUT,
+  InputDAC = AD56X4_SETMODE_INPUT_DAC,
+  InputDACAll = AD56X4_SETMODE_INPUT_DAC_ALL
+};
+
+enum class AD56X4Channel : byte
+{
+  A = AD56X4_CHANNEL_A,
+  B = AD56X4_CHANNEL_B,
+  C = AD56X4_CHANNEL_C,
+  D = AD56X4_CHANNEL_D,
+  All = AD56X4_CHANNEL_ALL
+};
+
+enum class AD56X4PowerMode : byte
+{
+  Normal = AD56X4_POWERMODE_NORMAL,
+  PowerDown1K = AD56X4_POWERMODE_POWERDOWN_1K,
+  PowerDown100K = AD56X4_POWERMODE_POWERDOWN_100K,
+  TriState = AD56X4_POWERMODE_TRISTATE
+};
+
+/* Set of channels (bits 3 through 0 for channels D through A), which
+   can only be made from channels, or empty (e.g. for setInputMode to
+   have no channel follow its input register, or to build a set up
+   with |=).
+*/
+class AD56X4ChannelMask
+{
+  
+  public:
+  
+    constexpr AD56X4ChannelMask () : bits(0)
+    {
+    }
+    
+    constexpr AD56X4ChannelMask (AD56X4Channel channel)
+      : bits(channel == AD56X4Channel::All ? 0x0F
+             : 1 << (byte)channel)
+    {
+    }
+    
+    constexpr AD56X4ChannelMask operator|
+      (AD56X4ChannelMask other) const
+    {
+      return AD56X4ChannelMask(bits | other.bits,0);
+    }
+    
+    AD56X4ChannelMask & operator|= (AD56X4ChannelMask other)
+    {
+      bits |= other.bits;
+      return *this;
+    }
+    
+    constexpr byte mask () const
+    {
+      return bits;
+    }
+    
+  private:
+    
+    constexpr AD56X4ChannelMask (byte bits, int) : bits(bits)
+    {
+    }
+    
+    byte bits;
+    
+};
+
+constexpr AD56X4ChannelMask operator| (AD56X4Channel a, AD56X4Channel b)
+{
+  return AD56X4ChannelMask(a) | AD56X4ChannelMask(b);
+}
+
+template <class Bus>
+class AD56X4TypedCommands
+{
+  
+  public:
+  
+    typedef typename Bus::Target Target;
+    
+    // Message headers and power up-down data. Both are constants when
+    // their arguments are.
+    
+    static constexpr byte makeHeader (AD56X4SetMode setMode,
+                                      AD56X4Channel channel)
+    {
+      return (byte)setMode | (byte)channel;
+    }
+    static constexpr word makePowerData (AD56X4PowerMode powerMode,
+                                         AD56X4ChannelMask channels)
+    {
+      return (word)((byte)powerMode | channels.mask());
+    }
+    
+    // The commands, like in AD56X4Commands.
+    
+    template <AD56X4SetMode setMode, AD56X4Channel channel>
+    static inline void setChannel (Target target, word value)
+    {
+      constexpr byte header = makeHeader(setMode,channel);
+      Bus::writeMessage(target,header,value);
+    }
+    static inline void setChannel (Target target,
+                                   AD56X4SetMode setMode,
+                                   AD56X4Channel channel, word value)
+    {
+      Bus::writeMessage(target,makeHeader(setMode,channel),value);
+    }
+    static inline void setChannel (Target target,
+                                   AD56X4SetMode setMode,
+                                   const word values[])
+    {
+      byte headers[4];
+      headers[0] = makeHeader(setMode,AD56X4Channel::D);
+      headers[1] = makeHeader(setMode,AD56X4Channel::C);
+      headers[2] = makeHeader(setMode,AD56X4Channel::B);
+      headers[3] = makeHeader(setMode,AD56X4Channel::A);
+      Bus::writeMessages(target,headers,values,4);
+    }
+    
+    static inline void commitChannels (Target target,
+                                       const word values[])
+    {
+      AD56X4Commands<Bus>::commitChannels(target,values);
+    }
+    
+    template <AD56X4Channel channel>
+    static inline void updateChannel (Target target)
+    {
+      constexpr byte header =
+        makeHeader(AD56X4_COMMAND_UPDATE_DAC_REGISTER,channel);
+      Bus::writeMessage(target,header,0);
+    }
+    static inline void updateChannel (Target target,
+                                      AD56X4Channel channel)
+    {
+      Bus::writeMessage(target,
+                        makeHeader(AD56X4_COMMAND_UPDATE_DAC_REGISTER,
+                                   channel),0);
+    }
+    
+    static inline void powerUpDown (Target target,
+                                    AD56X4PowerMode powerMode,
+                                    AD56X4ChannelMask channels)
+    {
+      Bus::writeMessage(target,AD56X4_COMMAND_POWER_UPDOWN,
+                        makePowerData(powerMode,channels));
+    }
+    
+    static inline void reset (Target target, boolean fullReset)
+    {
+      Bus::writeMessage(target,AD56X4_COMMAND_RESET,(word)fullReset);
+    }
+    
+    /* The channels given are set to have their DAC registers follow
+       their input registers (see AD56X4Commands::setInputMode).
+    */
+    static inline void setInputMode (Target target,
+                                     AD56X4ChannelMask channels)
+    {
+      Bus::writeMessage(target,AD56X4_COMMAND_SET_LDAC,channels.mask());
+    }
+    
+    static inline void useInternalReference (Target target,
+                                             boolean yesno)
+    {
+      Bus::writeMessage(target,AD56X4_COMMAND_REFERENCE_ONOFF,
+                        (word)yesno);
+    }
+    
+  private:
+    
+    // The header of the update command, which takes a channel but no
+    // set mode. It is private so that no raw command byte can be
+    // given from outside.
+    
+    static constexpr byte makeHeader (byte command,
+                                      AD56X4Channel channel)
+    {
+      return AD56X4MakeHeader(command,(byte)channel);
+    }
+    
+};
+
+#endif
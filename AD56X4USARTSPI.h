@@ -0,0 +1,247 @@
+/* Copyright (c) 2026, Freja Nordsiek
+   All rights reserved.
+   
+   Redistribution and use in source and binary forms, with or
+   without modification, are permitted provided that the
+   following conditions are met:
+   
+   1. Redistributions of source code must retain the above
+   copyright notice, this list of conditions and the following disclaimer.
+   
+   2. Redistributions in binary form must reproduce the above
+   copyright notice, this list of conditions and the following
+   disclaimer in the documentation and/or other materials
+   provided with the distribution.
+   
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+   NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+   LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+   HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+   OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*
+   AD56X4USARTSPI.h: SPI bus for the AD56X4 library on an AVR USART
+                     in Master SPI Mode (MSPIM).
+   
+   Author:   Freja Nordsiek
+   Notes:
+   History:  * 2026-10-16 Created.
+*/
+
+/* The hardware SPI of the AVR has no transmit buffer, so there is
+   always a gap between bytes while the next one is loaded. The
+   USARTs of the ATmega328P/168 and ATmega1280/2560 can be put in
+   Master SPI Mode, where the transmit data register (UDR) is double
+   buffered. The next byte is already waiting when the current one
+   finishes shifting, so the 24 bits of a message go out back to back
+   (as fast as fosc/2). The chip's DIN goes to the USART's TXD pin,
+   its SCLK to the USART's XCK pin, and its SYNC to any pin.
+   
+     USART  ATmega328P         ATmega2560
+            TXD     XCK        TXD       XCK
+     0      PD1 (1) PD4 (4)    PE1 (1)   PE2 (not on the Mega)
+     1      -       -          PD3 (18)  PD5 (not on the Mega)
+     2      -       -          PH1 (16)  PH2 (not on the Mega)
+     3      -       -          PJ1 (14)  PJ2 (not on the Mega)
+   
+   The Slave Select pin can't be raised until the last bit of a
+   message is out, so the next message's first byte can't be put in
+   the buffer early (it would be clocked in before the Slave Select
+   pin goes high). Instead, in a burst, the next message is prepared
+   while the current one is finishing so it is written the moment the
+   Slave Select pin has gone high and back low. Interrupts are held
+   off while each message is sent so that the end of the message is
+   detected reliably.
+   
+     typedef AD56X4USARTSPI<10> DACBus;   // SYNC on pin 10, USART0
+     DACBus dacBus;
+     
+     DACBus::begin();
+     AD56X4Commands<DACBus>::reset(dacBus, true);
+*/
+
+#ifndef AD56X4USARTSPI_h
+#define AD56X4USARTSPI_h
+
+#include "Arduino.h"
+#include "AD56X4.h"
+#include "AD56X4SoftSPI.h"
+
+#if defined(UDR0)
+
+/* The registers and XCK pin of each USART. The data direction
+   register of XCK is given by its data memory address.
+*/
+template <uint8_t usart>
+struct AD56X4USARTRegisters;
+
+#define AD56X4_USART_REGISTERS(n, xckDDR, xckBit) \
+  template <> \
+  struct AD56X4USARTRegisters<n> \
+  { \
+    static inline volatile uint8_t &UCSRA () { return UCSR##n##A; } \
+    static inline volatile uint8_t &UCSRB () { return UCSR##n##B; } \
+    static inline volatile uint8_t &UCSRC () { return UCSR##n##C; } \
+    static inline volatile uint16_t &UBRR () { return UBRR##n; } \
+    static inline volatile uint8_t &UDR () { return UDR##n; } \
+    static const uint8_t UDRE = UDRE##n; \
+    static const uint8_t TXC = TXC##n; \
+    static const uint8_t TXEN = TXEN##n; \
+    static const uint8_t MSPIM = _BV(UMSEL##n##1) | _BV(UMSEL##n##0); \
+    static const uint8_t MODE1 = _BV(UCPHA##n); \
+    static inline void xckOutput () { _SFR_MEM8(xckDDR) |= _BV(xckBit); } \
+  };
+
+#if defined(__AVR_ATmega2560__) || defined(__AVR_ATmega1280__)
+AD56X4_USART_REGISTERS(0, 0x2D, 2)
+AD56X4_USART_REGISTERS(1, 0x2A, 5)
+AD56X4_USART_REGISTERS(2, 0x101, 2)
+AD56X4_USART_REGISTERS(3, 0x104, 2)
+#else
+AD56X4_USART_REGISTERS(0, 0x2A, 4)
+#endif
+
+#undef AD56X4_USART_REGISTERS
+
+
+
+/* Bus policy (see AD56X4Commands.h) sending on USART number usart in
+   Master SPI Mode with the Slave Select pin SS_pin. The Target is the
+   bus object itself, which holds nothing.
+*/
+template <uint8_t SS_pin, uint8_t usart = 0>
+class AD56X4USARTSPI
+{
+  
+  public:
+  
+    typedef const AD56X4USARTSPI &Target;
+    
+    /* Puts the USART in Master SPI Mode with SPI_MODE1 and MSB first
+       and sets the pins up. The clock is fosc / (2 * (ubrr + 1)),
+       so the default ubrr of 0 gives the fastest possible (8 MHz on
+       a 16 MHz board), which the chip can easily take. The USART
+       can't be used as a serial port until it is set up again.
+    */
+    static void begin (word ubrr = 0)
+    {
+      SYNC::high();
+      pinMode(SS_pin,OUTPUT);
+      
+      // The baud rate register must be zero while the USART is
+      // being enabled (see the data sheet).
+      
+      USART::UBRR() = 0;
+      USART::xckOutput();
+      USART::UCSRC() = USART::MSPIM | USART::MODE1;
+      USART::UCSRB() = _BV(USART::TXEN);
+      USART::UBRR() = ubrr;
+    }
+    
+    static inline void writeMessage (Target, byte header, word data)
+    {
+      uint8_t oldSREG = SREG;
+      cli();
+      
+      selectAndStart(header);
+      finishMessage(data);
+      AD56X4_TRACE_SYNC(HIGH);
+      SYNC::high();
+      
+      SREG = oldSREG;
+    }
+    static inline void writeMessages (Target, const byte headers[],
+                                      const word data[], byte count)
+    {
+      if (count == 0)
+        return;
+      
+      uint8_t oldSREG = SREG;
+      cli();
+      
+      selectAndStart(headers[0]);
+      
+      for (byte i = 0; i < count; i++)
+        {
+          
+          finishMessage(data[i]);
+          
+          // Have the next message's first byte (and hence the next
+          // iteration) ready to go while the Slave Select pin goes
+          // high and low again.
+          
+          AD56X4_TRACE_SYNC(HIGH);
+          SYNC::high();
+          
+          if (i + 1 < count)
+            {
+              byte next = headers[i + 1];
+              
+              // Let pending interrupts in between messages.
+              
+              SREG = oldSREG;
+              cli();
+              
+              selectAndStart(next);
+            }
+          
+        }
+      
+      SREG = oldSREG;
+    }
+    
+  private:
+    typedef AD56X4USARTRegisters<usart> USART;
+    typedef AD56X4FastPin<SS_pin> SYNC;
+    
+    // Lowers the Slave Select pin and puts the first byte of a
+    // message in the buffer.
+    
+    static inline void selectAndStart (byte header)
+    {
+      AD56X4_TRACE_SYNC(LOW);
+      SYNC::low();
+      AD56X4_TRACE_BYTE(header);
+      USART::UDR() = header;
+    }
+    
+    // Sends the data word of a message after its first byte and waits
+    // until the last bit is out. Each byte goes in the buffer as soon
+    // as there is room so there is no gap between them. TXC is
+    // cleared (by writing a one to it) just before the last byte goes
+    // in, so it is only set once that byte has been shifted out.
+    
+    static inline void finishMessage (word data)
+    {
+      byte high = highByte(data);
+      byte low = lowByte(data);
+      
+      while (!(USART::UCSRA() & _BV(USART::UDRE)))
+        ;
+      AD56X4_TRACE_BYTE(high);
+      USART::UDR() = high;
+      
+      while (!(USART::UCSRA() & _BV(USART::UDRE)))
+        ;
+      USART::UCSRA() |= _BV(USART::TXC);
+      AD56X4_TRACE_BYTE(low);
+      USART::UDR() = low;
+      
+      while (!(USART::UCSRA() & _BV(USART::TXC)))
+        ;
+    }
+    
+};
+
+#endif
+
+#endif
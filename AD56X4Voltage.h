@@ -0,0 +1,186 @@
+/* Copyright (c) 2026, Freja Nordsiek
+   All rights reserved.
+   
+   Redistribution and use in source and binary forms, with or
+   without modification, are permitted provided that the
+   following conditions are met:
+   
+   1. Redistributions of source code must retain the above
+   copyright notice, this list of conditions and the following disclaimer.
+   
+   2. Redistributions in binary form must reproduce the above
+   copyright notice, this list of conditions and the following
+   disclaimer in the documentation and/or other materials
+   provided with the distribution.
+   
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+   NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+   LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+   HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+   OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*
+   AD56X4Voltage.h: Setting AD56X4 channels in millivolts.
+   
+   Author:   Freja Nordsiek
+   Notes:    Doesn't need Arduino.h. Needs C++11 (see AD56X4Chip.h).
+   History:  * 2026-10-16 Created.
+*/
+
+/* An AD56X4Voltage is a chip of a particular variant (see
+   AD56X4Chip.h) on the bus Bus whose channels are set in millivolts.
+   It knows the full scale voltage from the reference in use, which
+   is an external reference of a given voltage (the output goes up to
+   the reference) or the internal reference of the R chips (1.25 V on
+   the -3 parts and 2.5 V on the -5 parts, with the output going up to
+   twice that). When the reference is set, a fixed point reciprocal of
+   the full scale voltage is worked out once, so that turning
+   millivolts into a code is just a 16 by 32 bit multiply and a shift,
+   rounded to the chip's resolution (no division or float).
+   
+     AD56X4Device device(10);
+     AD56X4Voltage<AD5644R, AD56X4HardwareSPI> dac(device);
+     
+     dac.useInternalReference(AD56X4_INTERNAL_REFERENCE_5);
+     dac.setVoltage(AD56X4_SETMODE_INPUT_DAC, AD56X4_CHANNEL_A, 3300);
+*/
+
+#ifndef AD56X4Voltage_h
+#define AD56X4Voltage_h
+
+#include "AD56X4Chip.h"
+
+/* Internal reference voltages (in millivolts) of the -3 and -5 parts
+   of the AD56X4R chips.
+*/
+#define AD56X4_INTERNAL_REFERENCE_3 1250
+#define AD56X4_INTERNAL_REFERENCE_5 2500
+
+template <class Variant, class Bus>
+class AD56X4Voltage
+{
+  
+  private:
+    typedef AD56X4Chip<Variant,Bus> Chip;
+    
+  public:
+  
+    typedef typename Bus::Target Target;
+    
+    /* The chip is given by target, which must stay around as long as
+       this object. The reference must be set before any voltages.
+    */
+    AD56X4Voltage (AD56X4HeldTarget<Bus> target) : target(target)
+    {
+      setFullScale(0);
+    }
+    
+    /* Uses an external reference of referenceMillivolts, which is the
+       most the outputs can go to. On chips with an internal
+       reference, it is turned off.
+    */
+    void useExternalReference (word referenceMillivolts)
+    {
+      if (Variant::hasInternalReference)
+        AD56X4Commands<Bus>::useInternalReference(target,false);
+      setFullScale(referenceMillivolts);
+    }
+    
+    /* Turns on the internal reference, which is
+       AD56X4_INTERNAL_REFERENCE_3 or AD56X4_INTERNAL_REFERENCE_5
+       depending on the part, and the outputs can go to twice that.
+       Fails to compile for chips without one.
+    */
+    void useInternalReference (word referenceMillivolts)
+    {
+      Chip::useInternalReference(target,true);
+      setFullScale(2 * referenceMillivolts);
+    }
+    
+    /* The most the outputs can go to (in millivolts), or 0xFFFF if
+       the reference hasn't been set.
+    */
+    inline word fullScaleMillivolts () const
+    {
+      return fullScale;
+    }
+    
+    /* Returns the code at the chip's resolution closest to
+       millivolts, which is limited to the full scale (or zero if the
+       reference hasn't been set).
+    */
+    inline word toCode (word millivolts) const
+    {
+      if (reciprocal == 0)
+        return 0;
+      if (millivolts >= fullScale)
+        return Chip::fullScale;
+      word code = (word)(((uint32_t)millivolts * reciprocal
+                          + (1UL << (shift - 1))) >> shift);
+      return (code > Chip::fullScale) ? Chip::fullScale : code;
+    }
+    
+    // Like setChannel and commitChannels, with the values in
+    // millivolts.
+    
+    void setVoltage (byte setMode, byte channel, word millivolts)
+    {
+      Chip::setChannel(target,setMode,channel,toCode(millivolts));
+    }
+    void setVoltage (byte setMode, const word millivolts[])
+    {
+      word codes[4];
+      toCodes(millivolts,codes);
+      Chip::setChannel(target,setMode,codes);
+    }
+    void commitVoltages (const word millivolts[])
+    {
+      word codes[4];
+      toCodes(millivolts,codes);
+      Chip::commitChannels(target,codes);
+    }
+    
+  private:
+    
+    /* The code is millivolts * 2^bits / fullScale, which is worked
+       out as (millivolts * reciprocal) >> shift with reciprocal being
+       2^31 / fullScale, so that the product fits in 32 bits.
+    */
+    static constexpr byte shift = 31 - Variant::bits;
+    
+    void setFullScale (word millivolts)
+    {
+      // With no reference, every voltage is turned into zero (see
+      // toCode).
+      if (millivolts == 0)
+        {
+          fullScale = 0xFFFF;
+          reciprocal = 0;
+          return;
+        }
+      fullScale = millivolts;
+      reciprocal = ((1UL << 31) + millivolts / 2) / millivolts;
+    }
+    
+    void toCodes (const word millivolts[], word codes[]) const
+    {
+      for (byte i = 0; i < 4; i++)
+        codes[i] = toCode(millivolts[i]);
+    }
+    
+    Target target;
+    word fullScale;
+    uint32_t reciprocal;
+    
+};
+
+#endif
@@ -0,0 +1,247 @@
+/* Copyright (c) 2026, Freja Nordsiek
+   All rights reserved.
+   
+   Redistribution and use in source and binary forms, with or
+   without modification, are permitted provided that the
+   following conditions are met:
+   
+   1. Redistributions of source code must retain the above
+   copyright notice, this list of conditions and the following disclaimer.
+   
+   2. Redistributions in binary form must reproduce the above
+   copyright notice, this list of conditions and the following
+   disclaimer in the documentation and/or other materials
+   provided with the distribution.
+   
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+   NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+   LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+   HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+   OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*
+   AD56X4Wave.h: Playback of arbitrary waveforms from tables in flash
+                 on the four channels of an AD56X4.
+   
+   Author:   Freja Nordsiek
+   Notes:    Doesn't need Arduino.h.
+   History:  * 2026-10-16 Created.
+*/
+
+/* Fixed waveforms (pulses, staircases, recorded signals) kept in RAM
+   arrays soon use up the little SRAM there is. An AD56X4WavePlayer
+   plays a table of samples in flash (PROGMEM) on each channel,
+   reading only the current sample of each channel from flash when
+   the outputs are written, so nothing is copied to RAM and the
+   tables can be as big as flash. Each channel has its own table and
+   length, and either plays its table once and then holds the last
+   sample, or plays up to a loop end and then goes back to a loop
+   start forever. Each channel also has its own playback rate as a
+   ratio of integers: it advances step samples every hold ticks (so
+   1 and 4 is a quarter speed and 3 and 1 three times speed, skipping
+   samples). Channels without a table are 0.
+   
+     const word pulse[512] PROGMEM = { ... };
+     
+     AD56X4WavePlayer player;
+     
+     player.setTable(AD56X4_CHANNEL_A, pulse, 512);
+     player.setLoop(AD56X4_CHANNEL_A, 0, 512);
+     player.setRate(AD56X4_CHANNEL_A, 1, 2);  // Half speed.
+     
+     player.commit<AD56X4HardwareSPI>(device);
+     player.step();
+   
+   On AVR based Arduinos, the tables must be in the first 64 KB of
+   flash (where PROGMEM puts them), as that is all a pointer reaches.
+*/
+
+#ifndef AD56X4Wave_h
+#define AD56X4Wave_h
+
+#include "AD56X4Commands.h"
+
+class AD56X4WavePlayer
+{
+  
+  public:
+  
+    /* All channels start without a table. */
+    AD56X4WavePlayer ()
+    {
+      for (byte i = 0; i < 4; i++)
+        setTable(i,0,0);
+    }
+    
+    // Channels are AD56X4_CHANNEL_A through AD56X4_CHANNEL_D (0
+    // through 3).
+    
+    /* Sets the table (in flash) of length samples that a channel
+       plays, from the start, once, at a rate of one sample per
+       tick. A null table or zero length makes the channel 0.
+    */
+    void setTable (byte channel, const word *table, word length)
+    {
+      Channel &c = channels[channel & 3];
+      c.table = length != 0 ? table : 0;
+      c.length = length;
+      c.loopStart = 0;
+      c.loopEnd = 0;
+      c.step = 1;
+      c.hold = 1;
+      restart(channel);
+    }
+    
+    /* Makes a channel go back to loopStart every time it reaches
+       loopEnd (which is one past the last sample of the loop, and
+       at most the length). If loopStart isn't before loopEnd, the
+       channel plays once instead.
+    */
+    void setLoop (byte channel, word loopStart, word loopEnd)
+    {
+      Channel &c = channels[channel & 3];
+      if (loopEnd > c.length)
+        loopEnd = c.length;
+      if (loopStart >= loopEnd)
+        loopStart = loopEnd = 0;
+      c.loopStart = loopStart;
+      c.loopEnd = loopEnd;
+    }
+    
+    /* Sets a channel to advance step samples every hold ticks (both
+       at least 1).
+    */
+    void setRate (byte channel, byte step, byte hold)
+    {
+      Channel &c = channels[channel & 3];
+      c.step = step != 0 ? step : 1;
+      c.hold = hold != 0 ? hold : 1;
+      c.ticks = 0;
+    }
+    
+    /* Starts a channel, or all of them, from the beginning of its
+       table again.
+    */
+    void restart (byte channel)
+    {
+      Channel &c = channels[channel & 3];
+      c.position = 0;
+      c.ticks = 0;
+      c.done = (c.table == 0);
+    }
+    void restart ()
+    {
+      for (byte i = 0; i < 4; i++)
+        restart(i);
+    }
+    
+    /* Returns whether a channel is still playing (it has a table and
+       either loops or hasn't reached the end of its table).
+    */
+    inline boolean playing (byte channel) const
+    {
+      return !channels[channel & 3].done;
+    }
+    
+    /* The position (sample index) a channel is at in its table. */
+    inline word position (byte channel) const
+    {
+      return channels[channel & 3].position;
+    }
+    
+    /* Advances all channels by one tick. */
+    void step ()
+    {
+      
+      for (byte i = 0; i < 4; i++)
+        {
+          
+          Channel &c = channels[i];
+          if (c.done || ++c.ticks < c.hold)
+            continue;
+          c.ticks = 0;
+          
+          // Advance, watching for the word overflowing on long
+          // tables, and go around the loop (as many times as a big
+          // step needs) or stop at the last sample.
+          
+          word p = c.position + c.step;
+          boolean overflow = p < c.position;
+          
+          if (c.loopEnd != 0)
+            {
+              word loopLength = c.loopEnd - c.loopStart;
+              if (overflow)
+                p += (word)(0 - c.loopEnd) + c.loopStart;
+              while (p >= c.loopEnd)
+                p -= loopLength;
+            }
+          else if (overflow || p >= c.length)
+            {
+              p = c.length - 1;
+              c.done = true;
+            }
+          
+          c.position = p;
+          
+        }
+      
+    }
+    
+    /* The current sample of a channel, or of all four (channel D to
+       A order, for setChannel and commitChannels), read from flash.
+    */
+    inline word sample (byte channel) const
+    {
+      const Channel &c = channels[channel & 3];
+      if (c.table == 0)
+        return 0;
+      return pgm_read_word(c.table + c.position);
+    }
+    inline void samples (word values[]) const
+    {
+      for (byte i = 0; i < 4; i++)
+        values[3-i] = sample(i);
+    }
+    
+    /* Writes the current samples of all four channels to the chip
+       target on the bus Bus with commitChannels, so the outputs all
+       change at the same moment.
+    */
+    template <class Bus>
+    void commit (typename Bus::Target target) const
+    {
+      word values[4];
+      samples(values);
+      AD56X4Commands<Bus>::commitChannels(target,values);
+    }
+    
+  private:
+    
+    struct Channel
+    {
+      const word *table;
+      word length;
+      word loopStart;
+      word loopEnd;
+      word position;
+      byte step;
+      byte hold;
+      byte ticks;
+      boolean done;
+    };
+    
+    Channel channels[4];
+    
+};
+
+#endif
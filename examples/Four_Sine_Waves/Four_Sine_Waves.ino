@@ -38,24 +38,33 @@
    Author:   Freja Nordsiek
    Notes:
    History:  * 2013-08-17 Created.
+             * 2026-10-16 Uses commitChannels.
+             * 2026-10-16 Uses AD56X4DDS instead of float sin().
 */
 
 #include "Arduino.h"
-#include "math.h"
 #include <SPI.h>
 #include <AD56X4.h>
+#include <AD56X4DDS.h>
 
 // Output pin for the Slave Select SPI line of the AD56X4.
 
 int AD56X4_SS_pin = 10;
 
-// Define the sine wave frequencies for each channel in Hz, the
-// initial phases in degrees, the offsets, and the amplitudes.
+// Define the sine wave frequencies for each channel in mHz, the
+// initial phases (65536 is 360 degrees), the offsets, and the
+// amplitudes.
 
-float frequencies[] = {1e1, 1e1, 1e1, 1e1};
-float phases[] = {0, 90, 180, 270};
-float offsets[] = {32768, 32768, 32768, 32768};
-float amplitudes[] = {32600, 32600, 32600, 32600};
+unsigned long frequencies[] = {10000, 10000, 10000, 10000};
+word phases[] = {0, 0x4000, 0x8000, 0xC000};
+word offsets[] = {32768, 32768, 32768, 32768};
+word amplitudes[] = {32600, 32600, 32600, 32600};
+
+// The sine waves, advanced in microseconds, and the time they were
+// last advanced to.
+
+AD56X4DDS dds;
+unsigned long lastTime;
 
 void setup()
 {
@@ -75,53 +84,40 @@ void setup()
   
   AD56X4.reset(AD56X4_SS_pin,true);
   
+  // Set up the sine wave for each channel (0 through 3 are A
+  // through D).
+  
+  for (int i = 0; i < 4; i++)
+    {
+      dds.setFrequency(i,frequencies[i]);
+      dds.setPhase(i,phases[i]);
+      dds.setOffset(i,offsets[i]);
+      dds.setAmplitude(i,amplitudes[i]);
+    }
+  
+  lastTime = micros();
   
 }
 
 void loop()
 {
   
-  // Get the current time.
-  
-  float t = 1e-6 * float(micros());
-  
-  // Array to help in giving the library the right channel.
+  // Advance the sine waves by the time since the last time they
+  // were advanced (the subtraction is right even when micros()
+  // wraps around).
   
-  byte channels[] = {AD56X4_CHANNEL_A, AD56X4_CHANNEL_B,
-                     AD56X4_CHANNEL_C, AD56X4_CHANNEL_D};
+  unsigned long now = micros();
+  dds.advance(now - lastTime);
+  lastTime = now;
   
-  // Calculate the sine wave and put it in the input register for
-  // each channel (not output by the DAC yet).
+  // Get the values for each channel (in channel D to A order).
   
-  for (int i = 0; i < 4; i++)
-    {
-      
-      // Calculate the sine wave value.
-      
-      float y = offsets[i] + amplitudes[i]
-                * sin(2.0*M_PI*(t*frequencies[i] + phases[i]/360.0));
-      
-      // Convert to a word (unsigned int) making sure to keep it
-      // in the range [0, 0xFFFF].
-      
-      word output = (word)y;
-      
-      if (y > 0xFFFF)
-        output = 0xFFFF;
-      else if (y < 0)
-        output = 0;
-        
-      // Write the output to the i'th channel making sure that only
-      // the input register is set (not output yet).
-        
-      AD56X4.setChannel(AD56X4_SS_pin, AD56X4_SETMODE_INPUT,
-                        channels[i], output);
-      
-    }
+  word outputs[4];
+  dds.samples(outputs);
   
-  // Update all the DAC registers so that the outputs of the DAC
-  // are now the new sine wave values. This is synchronous.
+  // Write all four channels so that the outputs of the DAC are all
+  // changed to the new sine wave values at the same moment.
   
-  AD56X4.updateChannel(AD56X4_SS_pin, AD56X4_CHANNEL_ALL);
+  AD56X4.commitChannels(AD56X4_SS_pin, outputs);
   
 }
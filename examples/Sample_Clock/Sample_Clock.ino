@@ -0,0 +1,134 @@
+/* Copyright (c) 2026, Freja Nordsiek
+   All rights reserved.
+   
+   Redistribution and use in source and binary forms, with or
+   without modification, are permitted provided that the
+   following conditions are met:
+   
+   1. Redistributions of source code must retain the above
+   copyright notice, this list of conditions and the following disclaimer.
+   
+   2. Redistributions in binary form must reproduce the above
+   copyright notice, this list of conditions and the following
+   disclaimer in the documentation and/or other materials
+   provided with the distribution.
+   
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+   NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+   LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+   HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+   OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/* Sample Clock
+   
+   This example controls an Analog Devices AD56X4 Quad Channel DAC
+   (Digital to Analog Converter) by SPI and writes a 10 Hz sine
+   wave to each channel that are all 90 degrees out of phase, like
+   Four_Sine_Waves, but at a fixed 5 kHz sample rate from the Timer1
+   interrupt instead of as fast as loop() runs. Once a second, the
+   achieved sample rate, the number of overruns, and the longest the
+   interrupt has taken are printed to the serial port. Only works on
+   AVR based Arduinos.
+   
+   Author:   Freja Nordsiek
+   Notes:
+   History:  * 2026-10-16 Created.
+*/
+
+#include "Arduino.h"
+#include <SPI.h>
+#include <AD56X4.h>
+#include <AD56X4DDS.h>
+// The sample clock's Timer1 interrupt handler is defined here.
+
+#define AD56X4_SAMPLE_CLOCK_ISR
+#include <AD56X4SampleClock.h>
+
+// Output pin for the Slave Select SPI line of the AD56X4.
+
+int AD56X4_SS_pin = 10;
+
+// The sample rate in Hz.
+
+const unsigned long sampleRate = 5000;
+
+// The sine waves, advanced one sample at a time, and the handle of
+// the chip, which must stay around while the sample clock runs.
+
+AD56X4DDS dds(sampleRate);
+AD56X4Device device(AD56X4_SS_pin);
+
+// Gives the next sample (in channel D to A order). It is called from
+// the sample clock's interrupt.
+
+void nextSample(word values[])
+{
+  dds.step();
+  dds.samples(values);
+}
+
+void setup()
+{
+  
+  Serial.begin(9600);
+  
+  // Setup SPI. This means setting pin 10 to output (arduino must
+  // be the master), the AD56X4 Slave Select pin to output, the
+  // SPI clock (chip's 50 MHz is way faster than our 8 MHz max),
+  // and start SPI.
+  
+  pinMode(10,OUTPUT);
+  pinMode(AD56X4_SS_pin,OUTPUT);
+  SPI.setClockDivider(SPI_CLOCK_DIV2);
+  SPI.begin();
+  
+  // Reset the AD56X4, which will power it up and set all outputs
+  // to zero.
+  
+  AD56X4.reset(device,true);
+  
+  // Set up 10 Hz sine waves 90 degrees apart on channels A to D.
+  
+  for (int i = 0; i < 4; i++)
+    {
+      dds.setFrequency(i,10000);
+      dds.setPhase(i,i * 0x4000);
+      dds.setOffset(i,32768);
+      dds.setAmplitude(i,32600);
+    }
+  
+  // Start the sample clock.
+  
+  AD56X4SampleClock.begin(device,nextSample);
+  if (!AD56X4SampleClock.start(sampleRate))
+    Serial.println("Can't start the sample clock.");
+  
+}
+
+void loop()
+{
+  
+  delay(1000);
+  
+  Serial.print("Rate: ");
+  Serial.print(AD56X4SampleClock.achievedRate());
+  Serial.print(" Hz (set to ");
+  Serial.print(AD56X4SampleClock.sampleRate());
+  Serial.print(" Hz), overruns: ");
+  Serial.print(AD56X4SampleClock.overruns());
+  Serial.print(", worst interrupt: ");
+  Serial.print(AD56X4SampleClock.worstMicros());
+  Serial.println(" us");
+  
+  AD56X4SampleClock.clearStatistics();
+  
+}
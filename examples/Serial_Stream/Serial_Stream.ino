@@ -0,0 +1,111 @@
+/* Copyright (c) 2026, Freja Nordsiek
+   All rights reserved.
+   
+   Redistribution and use in source and binary forms, with or
+   without modification, are permitted provided that the
+   following conditions are met:
+   
+   1. Redistributions of source code must retain the above
+   copyright notice, this list of conditions and the following disclaimer.
+   
+   2. Redistributions in binary form must reproduce the above
+   copyright notice, this list of conditions and the following
+   disclaimer in the documentation and/or other materials
+   provided with the distribution.
+   
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+   NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+   LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+   HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+   OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/* Serial Stream
+   
+   This example controls an Analog Devices AD56X4 Quad Channel DAC
+   (Digital to Analog Converter) by SPI and writes samples streamed
+   from a PC over the serial port (see AD56X4Stream.h) at a fixed
+   5 kHz sample rate with the sample clock. Use host/streamsend on
+   the PC to send them. Only works on AVR based Arduinos.
+   
+     streamsend -b 500000 /dev/ttyACM0 samples.bin
+   
+   Author:   Freja Nordsiek
+   Notes:
+   History:  * 2026-10-16 Created.
+*/
+
+#include "Arduino.h"
+#include <SPI.h>
+#include <AD56X4.h>
+// The sample clock's Timer1 interrupt handler is defined here.
+
+#define AD56X4_SAMPLE_CLOCK_ISR
+#include <AD56X4SampleClock.h>
+#include <AD56X4Stream.h>
+
+// Output pin for the Slave Select SPI line of the AD56X4.
+
+int AD56X4_SS_pin = 10;
+
+// The handle of the chip, which must stay around while the sample
+// clock runs, and the receiver of the samples.
+
+AD56X4Device device(AD56X4_SS_pin);
+AD56X4StreamReceiver<HardwareSerial> stream(Serial);
+
+// Gives the next sample (in channel D to A order) from the stream.
+// It is called from the sample clock's interrupt.
+
+void nextSample(word values[])
+{
+  stream.next(values);
+}
+
+void setup()
+{
+  
+  // 8 bytes a sample at 5 kHz is 40 kB/s, which needs at least
+  // 400000 baud.
+  
+  Serial.begin(500000);
+  
+  // Setup SPI. This means setting pin 10 to output (arduino must
+  // be the master), the AD56X4 Slave Select pin to output, the
+  // SPI clock (chip's 50 MHz is way faster than our 8 MHz max),
+  // and start SPI.
+  
+  pinMode(10,OUTPUT);
+  pinMode(AD56X4_SS_pin,OUTPUT);
+  SPI.setClockDivider(SPI_CLOCK_DIV2);
+  SPI.begin();
+  
+  // Reset the AD56X4, which will power it up and set all outputs
+  // to zero.
+  
+  AD56X4.reset(device,true);
+  
+  // Start the sample clock, which outputs zeros until the PC starts
+  // streaming.
+  
+  AD56X4SampleClock.begin(device,nextSample);
+  AD56X4SampleClock.start(5000);
+  
+}
+
+void loop()
+{
+  
+  // Take in what has arrived and give credit back to the PC.
+  
+  stream.poll();
+  
+}
@@ -0,0 +1,231 @@
+/* Copyright (c) 2026, Freja Nordsiek
+   All rights reserved.
+   
+   Redistribution and use in source and binary forms, with or
+   without modification, are permitted provided that the
+   following conditions are met:
+   
+   1. Redistributions of source code must retain the above
+   copyright notice, this list of conditions and the following disclaimer.
+   
+   2. Redistributions in binary form must reproduce the above
+   copyright notice, this list of conditions and the following
+   disclaimer in the documentation and/or other materials
+   provided with the distribution.
+   
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+   NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+   LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+   HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+   OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*
+   AD56X4Host.cpp: Arduino core and SPI library stand-ins and the bus
+                   recorder for host builds of the AD56X4 library.
+   
+   Author:   Freja Nordsiek
+   Notes:    Host builds only. Not part of the Arduino library.
+   History:  * 2026-10-16 Created.
+*/
+
+#include <time.h>
+#include <vector>
+#include "Arduino.h"
+#include "SPI.h"
+#include "AD56X4Host.h"
+
+unsigned long AD56X4Host::frames = 0;
+unsigned long AD56X4Host::bytes = 0;
+unsigned long AD56X4Host::busClocks = 0;
+unsigned long AD56X4Host::shiftCycles = 0;
+unsigned long AD56X4Host::pinWrites = 0;
+unsigned long AD56X4Host::spiSetups = 0;
+unsigned int AD56X4Host::clockDivider = 4;
+
+// The trace is a list of events, each either a Slave Select change
+// or a byte.
+
+struct TraceEvent
+{
+  boolean isSync;
+  uint8_t value;
+};
+
+static std::vector<TraceEvent> trace;
+static boolean tracing = false;
+static unsigned long bytesSinceSelect = 0;
+
+void AD56X4Host::clear ()
+{
+  frames = 0;
+  bytes = 0;
+  busClocks = 0;
+  shiftCycles = 0;
+  pinWrites = 0;
+  spiSetups = 0;
+  bytesSinceSelect = 0;
+  trace.clear();
+}
+
+void AD56X4Host::startTrace ()
+{
+  trace.clear();
+  tracing = true;
+}
+void AD56X4Host::stopTrace ()
+{
+  tracing = false;
+}
+
+/* Prints the trace bit by bit, one message per line, as the bits on
+   MOSI while the Slave Select is low (MSB first, a space between
+   bytes) between the Slave Select going low (\) and high (/).
+*/
+void AD56X4Host::printTrace (FILE *file)
+{
+  for (size_t i = 0; i < trace.size(); i++)
+    {
+      if (trace[i].isSync)
+        {
+          if (trace[i].value == LOW)
+            fputs("\\ ",file);
+          else
+            fputs("/\n",file);
+        }
+      else
+        {
+          for (uint8_t bit = 0x80; bit != 0; bit >>= 1)
+            fputc((trace[i].value & bit) ? '1' : '0',file);
+          fputc(' ',file);
+        }
+    }
+}
+
+void AD56X4Host::recordSync (uint8_t level)
+{
+  if (level == HIGH && bytesSinceSelect > 0)
+    {
+      frames++;
+      bytesSinceSelect = 0;
+    }
+  if (tracing)
+    {
+      TraceEvent event = {true, level};
+      trace.push_back(event);
+    }
+}
+
+void AD56X4Host::recordByte (uint8_t value)
+{
+  bytes++;
+  bytesSinceSelect++;
+  busClocks += 8;
+  shiftCycles += 8 * clockDivider;
+  if (tracing)
+    {
+      TraceEvent event = {false, value};
+      trace.push_back(event);
+    }
+}
+
+
+
+// Arduino core stand-ins.
+
+void pinMode (uint8_t, uint8_t)
+{
+}
+
+void digitalWrite (uint8_t, uint8_t)
+{
+  AD56X4Host::pinWrites++;
+}
+
+static unsigned long long nowMicros ()
+{
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC,&now);
+  return (unsigned long long)now.tv_sec * 1000000ULL
+         + now.tv_nsec / 1000;
+}
+
+static const unsigned long long startMicros = nowMicros();
+
+unsigned long millis ()
+{
+  return (unsigned long)((nowMicros() - startMicros) / 1000);
+}
+
+unsigned long micros ()
+{
+  return (unsigned long)(nowMicros() - startMicros);
+}
+
+void delay (unsigned long ms)
+{
+  delayMicroseconds(ms * 1000);
+}
+
+void delayMicroseconds (unsigned int us)
+{
+  struct timespec wait;
+  wait.tv_sec = us / 1000000;
+  wait.tv_nsec = (us % 1000000) * 1000L;
+  nanosleep(&wait,0);
+}
+
+void noInterrupts ()
+{
+}
+
+void interrupts ()
+{
+}
+
+
+
+// SPI library stand-in. The bytes themselves are recorded by the
+// library's AD56X4_TRACE_BYTE hook (so that every bus is recorded the
+// same way), so a transfer only has to return what the chip would
+// send back, which is nothing.
+
+SPIClass SPI;
+
+byte SPIClass::transfer (byte)
+{
+  return 0;
+}
+
+void SPIClass::begin ()
+{
+}
+
+void SPIClass::end ()
+{
+}
+
+void SPIClass::setBitOrder (uint8_t)
+{
+  AD56X4Host::spiSetups++;
+}
+
+void SPIClass::setDataMode (uint8_t)
+{
+  AD56X4Host::spiSetups++;
+}
+
+void SPIClass::setClockDivider (uint8_t rate)
+{
+  static const unsigned int dividers[] = {4, 16, 64, 128, 2, 8, 32};
+  if (rate < 7)
+    AD56X4Host::clockDivider = dividers[rate];
+}
@@ -0,0 +1,84 @@
+/* Copyright (c) 2026, Freja Nordsiek
+   All rights reserved.
+   
+   Redistribution and use in source and binary forms, with or
+   without modification, are permitted provided that the
+   following conditions are met:
+   
+   1. Redistributions of source code must retain the above
+   copyright notice, this list of conditions and the following disclaimer.
+   
+   2. Redistributions in binary form must reproduce the above
+   copyright notice, this list of conditions and the following
+   disclaimer in the documentation and/or other materials
+   provided with the distribution.
+   
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+   NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+   LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+   HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+   OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*
+   AD56X4Host.h: Recorder of what the AD56X4 library puts on the bus
+                 in host builds. It is included before everything
+                 else (with the compiler's -include option) so that it
+                 can hook AD56X4_TRACE_SYNC and AD56X4_TRACE_BYTE.
+   
+   Author:   Freja Nordsiek
+   Notes:    Host builds only. Not part of the Arduino library.
+   History:  * 2026-10-16 Created.
+*/
+
+#ifndef AD56X4Host_h
+#define AD56X4Host_h
+
+#include <stdio.h>
+#include <stdint.h>
+
+/* Every Slave Select change and byte sent by any of the library's
+   buses is recorded, along with counts of what it took. A message
+   (frame) is counted each time a Slave Select pin (or group of them)
+   goes high after bytes were sent. The bus clocks are the SCK cycles
+   (8 per byte) and the shift cycles are the AVR CPU cycles those take
+   at the SPI clock divider in effect (SPI_CLOCK_DIV4 by default, like
+   on an Arduino).
+*/
+class AD56X4Host
+{
+  
+  public:
+  
+    static unsigned long frames;
+    static unsigned long bytes;
+    static unsigned long busClocks;
+    static unsigned long shiftCycles;
+    static unsigned long pinWrites;
+    static unsigned long spiSetups;
+    
+    static unsigned int clockDivider;
+    
+    static void clear ();
+    
+    static void startTrace ();
+    static void stopTrace ();
+    static void printTrace (FILE *file);
+    
+    static void recordSync (uint8_t level);
+    static void recordByte (uint8_t value);
+    
+};
+
+#define AD56X4_TRACE_SYNC(level) AD56X4Host::recordSync(level)
+#define AD56X4_TRACE_BYTE(value) AD56X4Host::recordByte(value)
+
+#endif
@@ -0,0 +1,176 @@
+/* Copyright (c) 2026, Freja Nordsiek
+   All rights reserved.
+   
+   Redistribution and use in source and binary forms, with or
+   without modification, are permitted provided that the
+   following conditions are met:
+   
+   1. Redistributions of source code must retain the above
+   copyright notice, this list of conditions and the following disclaimer.
+   
+   2. Redistributions in binary form must reproduce the above
+   copyright notice, this list of conditions and the following
+   disclaimer in the documentation and/or other materials
+   provided with the distribution.
+   
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+   NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+   LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+   HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+   OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*
+   AD56X4Original.cpp: Builds the original AD56X4.cpp (extracted from
+                       the first commit in git into host/original by
+                       the Makefile) into the host tools, with its
+                       class and object renamed so they don't clash
+                       with the library's, and the Arduino binary
+                       constants and trace recording it needs.
+   
+   Author:   Freja Nordsiek
+   Notes:    Host builds only. Not part of the Arduino library. The
+             direct SPDR writes of the library have no original to
+             compare with on the host, so they are only checked on
+             hardware.
+   History:  * 2026-10-16 Created.
+*/
+
+#include "Arduino.h"
+#include <SPI.h>
+#include "AD56X4Original.h"
+
+// The binary constants of the Arduino core's binary.h that the
+// original uses.
+
+#define B00000000 0x00
+#define B00000001 0x01
+#define B00000010 0x02
+#define B00000011 0x03
+#define B00000111 0x07
+#define B00001000 0x08
+#define B00001111 0x0F
+#define B00010000 0x10
+#define B00011000 0x18
+#define B00100000 0x20
+#define B00101000 0x28
+#define B00110000 0x30
+#define B00111000 0x38
+
+// The stand-ins don't record the Slave Select changes and bytes (the
+// library does it through its trace hooks), so the original is given
+// ones that do.
+
+static void tracedDigitalWrite (uint8_t pin, uint8_t level)
+{
+  digitalWrite(pin,level);
+  AD56X4_TRACE_SYNC(level);
+}
+
+class TracedSPIClass
+{
+  
+  public:
+  
+    static byte transfer (byte data)
+    {
+      AD56X4_TRACE_BYTE(data);
+      return SPI.transfer(data);
+    }
+    static void setBitOrder (uint8_t bitOrder)
+    {
+      SPI.setBitOrder(bitOrder);
+    }
+    static void setDataMode (uint8_t mode)
+    {
+      SPI.setDataMode(mode);
+    }
+    
+};
+
+static TracedSPIClass tracedSPI;
+
+// The original header is included first so that its include guard
+// keeps the library's AD56X4.h out when the original includes it.
+
+#define digitalWrite tracedDigitalWrite
+#define SPI tracedSPI
+#define AD56X4Class AD56X4OriginalClass
+#define AD56X4 AD56X4OriginalObject
+
+#include "original/AD56X4.h"
+#include "original/AD56X4.cpp"
+
+#undef digitalWrite
+#undef SPI
+
+void AD56X4Original::setChannel (int SS_pin, byte setMode,
+                                 byte channel, word value)
+{
+  AD56X4.setChannel(SS_pin,setMode,channel,value);
+}
+void AD56X4Original::setChannel (int SS_pin, byte setMode,
+                                 word values[])
+{
+  AD56X4.setChannel(SS_pin,setMode,values);
+}
+void AD56X4Original::setChannel (int SS_pin, byte setMode,
+                                 word value_D, word value_C,
+                                 word value_B, word value_A)
+{
+  AD56X4.setChannel(SS_pin,setMode,value_D,value_C,value_B,value_A);
+}
+
+void AD56X4Original::updateChannel (int SS_pin, byte channel)
+{
+  AD56X4.updateChannel(SS_pin,channel);
+}
+
+void AD56X4Original::powerUpDown (int SS_pin, byte powerMode,
+                                  boolean channels[])
+{
+  AD56X4.powerUpDown(SS_pin,powerMode,channels);
+}
+void AD56X4Original::powerUpDown (int SS_pin, byte powerMode,
+                                  boolean channel_D,
+                                  boolean channel_C,
+                                  boolean channel_B,
+                                  boolean channel_A)
+{
+  AD56X4.powerUpDown(SS_pin,powerMode,channel_D,channel_C,channel_B,
+                     channel_A);
+}
+void AD56X4Original::powerUpDown (int SS_pin, byte powerModes[])
+{
+  AD56X4.powerUpDown(SS_pin,powerModes);
+}
+
+void AD56X4Original::reset (int SS_pin, boolean fullReset)
+{
+  AD56X4.reset(SS_pin,fullReset);
+}
+
+void AD56X4Original::setInputMode (int SS_pin, boolean channels[])
+{
+  AD56X4.setInputMode(SS_pin,channels);
+}
+void AD56X4Original::setInputMode (int SS_pin, boolean channel_D,
+                                   boolean channel_C,
+                                   boolean channel_B,
+                                   boolean channel_A)
+{
+  AD56X4.setInputMode(SS_pin,channel_D,channel_C,channel_B,channel_A);
+}
+
+void AD56X4Original::useInternalReference (int SS_pin, boolean yesno)
+{
+  AD56X4.useInternalReference(SS_pin,yesno);
+}
@@ -0,0 +1,77 @@
+/* Copyright (c) 2026, Freja Nordsiek
+   All rights reserved.
+   
+   Redistribution and use in source and binary forms, with or
+   without modification, are permitted provided that the
+   following conditions are met:
+   
+   1. Redistributions of source code must retain the above
+   copyright notice, this list of conditions and the following disclaimer.
+   
+   2. Redistributions in binary form must reproduce the above
+   copyright notice, this list of conditions and the following
+   disclaimer in the documentation and/or other materials
+   provided with the distribution.
+   
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+   NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+   LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+   HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+   OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*
+   AD56X4Original.h: The public functions of the original AD56X4
+                     library (version 0.1.1, before bus sessions and
+                     everything after), for comparing the bit-level
+                     traces of the library with. They call the
+                     original AD56X4.cpp itself, taken from the first
+                     commit in git and built with its Slave Select
+                     changes and bytes recorded (see
+                     AD56X4Original.cpp).
+   
+   Author:   Freja Nordsiek
+   Notes:    Host builds only. Not part of the Arduino library.
+   History:  * 2026-10-16 Created.
+*/
+
+#ifndef AD56X4Original_h
+#define AD56X4Original_h
+
+#include "Arduino.h"
+
+namespace AD56X4Original
+{
+  
+  void setChannel (int SS_pin, byte setMode, byte channel, word value);
+  void setChannel (int SS_pin, byte setMode, word values[]);
+  void setChannel (int SS_pin, byte setMode, word value_D,
+                   word value_C, word value_B, word value_A);
+  
+  void updateChannel (int SS_pin, byte channel);
+  
+  void powerUpDown (int SS_pin, byte powerMode, boolean channels[]);
+  void powerUpDown (int SS_pin, byte powerMode, boolean channel_D,
+                    boolean channel_C, boolean channel_B,
+                    boolean channel_A);
+  void powerUpDown (int SS_pin, byte powerModes[]);
+  
+  void reset (int SS_pin, boolean fullReset);
+  
+  void setInputMode (int SS_pin, boolean channels[]);
+  void setInputMode (int SS_pin, boolean channel_D, boolean channel_C,
+                     boolean channel_B, boolean channel_A);
+  
+  void useInternalReference (int SS_pin, boolean yesno);
+  
+}
+
+#endif
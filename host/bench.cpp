@@ -0,0 +1,559 @@
+/* Copyright (c) 2026, Freja Nordsiek
+   All rights reserved.
+   
+   Redistribution and use in source and binary forms, with or
+   without modification, are permitted provided that the
+   following conditions are met:
+   
+   1. Redistributions of source code must retain the above
+   copyright notice, this list of conditions and the following disclaimer.
+   
+   2. Redistributions in binary form must reproduce the above
+   copyright notice, this list of conditions and the following
+   disclaimer in the documentation and/or other materials
+   provided with the distribution.
+   
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+   NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+   LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+   HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+   OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*
+   bench.cpp: Host benchmark of the AD56X4 library. For each public
+              overload, it reports the messages (frames), SPI setups,
+              bus clocks, and AVR CPU cycles spent shifting per call
+              (from the recorder in AD56X4Host.h) and the host time
+              per call, and then the same for full refreshes of banks
+              of chips and for sample clock ticks. Run with -t to
+              print a bit-level trace of one call of each instead.
+              First, the bit-level traces of the commands are
+              compared with those of the original library (built
+              from the first commit, see AD56X4Original.h), exiting
+              with 1 if any differ, and run with -c, that is all it
+              does.
+   
+   Author:   Freja Nordsiek
+   Notes:    Host builds only. Build and run with "make bench".
+   History:  * 2026-10-16 Created.
+*/
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "Arduino.h"
+#include <SPI.h>
+#include <AD56X4.h>
+#include <AD56X4Shadow.h>
+#include <AD56X4Chip.h>
+#include <AD56X4Plan.h>
+#include <AD56X4Power.h>
+#include <AD56X4Bank.h>
+#include <AD56X4Calibration.h>
+#include <AD56X4Voltage.h>
+#include <AD56X4Typed.h>
+#include <AD56X4Frame.h>
+#include <AD56X4DDS.h>
+#include <AD56X4SampleClock.h>
+#include <AD56X4Wave.h>
+#include <AD56X4Stream.h>
+#include <AD56X4Ramp.h>
+#include "AD56X4Host.h"
+#include "AD56X4Original.h"
+
+static const int SS_pin = 10;
+static AD56X4Device dac(SS_pin);
+static AD56X4Shadow<AD56X4HardwareSPI> shadow(dac);
+static AD56X4Plan plan;
+static AD56X4PowerManager<AD56X4HardwareSPI> power(dac);
+static AD56X4Calibration calibration;
+static AD56X4Voltage<AD5664R,AD56X4HardwareSPI> voltage(dac);
+static AD56X4Ramp<AD56X4HardwareSPI> ramp(dac);
+static AD56X4DDS dds;
+static AD56X4WavePlayer player;
+/* A serial port that has an 8 sample stream block arriving every
+   time it runs dry, for timing the stream receiver.
+*/
+class BlockPort
+{
+  
+  public:
+  
+    BlockPort () : index(sizeof(block))
+    {
+      block[0] = AD56X4_STREAM_SYNC;
+      block[1] = 8;
+      byte sum = 8;
+      for (int i = 2; i < 66; i++)
+        sum += block[i] = i;
+      block[66] = -sum;
+    }
+    
+    int available ()
+    {
+      if (index == sizeof(block))
+        index = 0;
+      return sizeof(block) - index;
+    }
+    int read ()
+    {
+      return block[index++];
+    }
+    size_t write (uint8_t value)
+    {
+      (void)value;
+      return 1;
+    }
+    
+  private:
+    
+    byte block[67];
+    unsigned int index;
+    
+};
+
+static BlockPort blockPort;
+static AD56X4StreamReceiver<BlockPort> stream(blockPort);
+static const word staircase[] PROGMEM = {0x0000, 0x2000, 0x4000,
+                                         0x6000, 0x8000, 0xA000,
+                                         0xC000, 0xE000, 0xFFFF};
+static word millivolts[] = {1000, 2000, 3300, 4500};
+static const AD56X4Frame boardInit[] PROGMEM = {
+  AD56X4Frame::reset(true),
+  AD56X4Frame::useInternalReference(true),
+  AD56X4Frame::powerUpDown(AD56X4_POWERMODE_TRISTATE,0x0C),
+  AD56X4Frame::setInputMode(0x00)
+};
+static float gains[] = {1.01f, 0.99f, 1.0f, 1.02f};
+static float offsets[] = {-12, 5, 0, 30};
+
+static word values[] = {0x1234, 0x5678, 0x9ABC, 0xDEF0};
+static boolean channels[] = {true, false, true, false};
+static byte powerModes[] = {AD56X4_POWERMODE_NORMAL,
+                            AD56X4_POWERMODE_POWERDOWN_1K,
+                            AD56X4_POWERMODE_POWERDOWN_100K,
+                            AD56X4_POWERMODE_TRISTATE};
+
+struct Benchmark
+{
+  const char *name;
+  void (*run) ();
+  boolean inSession;
+};
+
+static const Benchmark benchmarks[] = {
+  {"setChannel(pin, mode, channel, value)", []() {
+      AD56X4.setChannel(SS_pin,AD56X4_SETMODE_INPUT,
+                        AD56X4_CHANNEL_A,values[0]); }, false},
+  {"setChannel(pin, mode, values[])", []() {
+      AD56X4.setChannel(SS_pin,AD56X4_SETMODE_INPUT,values); }, false},
+  {"setChannel(pin, mode, D, C, B, A)", []() {
+      AD56X4.setChannel(SS_pin,AD56X4_SETMODE_INPUT,values[0],
+                        values[1],values[2],values[3]); }, false},
+  {"commitChannels(pin, values[])", []() {
+      AD56X4.commitChannels(SS_pin,values); }, false},
+  {"AD56X4Chip<AD5644R> commitChannels", []() {
+      AD56X4Chip<AD5644R,AD56X4HardwareSPI>::commitChannels(dac,
+                                                            values);
+    }, false},
+  {"AD56X4Plan 3 values, 2 power modes", []() {
+      plan.clear();
+      plan.setChannel(AD56X4_CHANNEL_A,values[0]);
+      plan.setChannel(AD56X4_CHANNEL_B,values[0]);
+      plan.setChannel(AD56X4_CHANNEL_C,values[1]);
+      plan.powerUpDown(AD56X4_POWERMODE_NORMAL,0x07);
+      plan.powerUpDown(AD56X4_POWERMODE_TRISTATE,0x08);
+      plan.send<AD56X4HardwareSPI>(dac); }, false},
+  {"commitChannels calibrated in float", []() {
+      word calibrated[4];
+      for (int i = 0; i < 4; i++)
+        {
+          float y = floorf(values[i] * gains[i] + offsets[i] + 0.5f);
+          calibrated[i] = (y > 0xFFFF) ? 0xFFFF : (y < 0) ? 0 : (word)y;
+        }
+      AD56X4.commitChannels(dac,calibrated); }, false},
+  {"commitChannels calibrated in integer", []() {
+      word calibrated[4];
+      calibration.applyAll(values,calibrated);
+      AD56X4.commitChannels(dac,calibrated); }, false},
+  {"AD56X4Voltage commitVoltages", []() {
+      voltage.commitVoltages(millivolts); }, false},
+  {"four sine samples in float", []() {
+      static float t = 0;
+      word samples[4];
+      t += 1e-4f;
+      for (int i = 0; i < 4; i++)
+        {
+          float y = 32768 + 32600 * sinf(2.0f * (float)M_PI
+                                         * (t * 10 + i * 0.25f));
+          samples[3-i] = (y > 0xFFFF) ? 0xFFFF : (y < 0) ? 0 : (word)y;
+        }
+      AD56X4.commitChannels(dac,samples); }, false},
+  {"four sine samples from AD56X4DDS", []() {
+      word samples[4];
+      dds.advance(100);
+      dds.samples(samples);
+      AD56X4.commitChannels(dac,samples); }, false},
+  {"AD56X4WavePlayer commit and step", []() {
+      player.commit<AD56X4HardwareSPI>(dac);
+      player.step(); }, false},
+  {"AD56X4StreamReceiver 8 sample block", []() {
+      word samples[4];
+      stream.poll();
+      while (stream.next(samples))
+        ; }, false},
+  {"AD56X4Ramp tick, two channels ramping", []() {
+      if (!ramp.ramping())
+        {
+          ramp.setTarget(AD56X4_CHANNEL_A,ramp.value(0) ? 0 : 0xFFFF);
+          ramp.setTarget(AD56X4_CHANNEL_C,ramp.value(2) ? 0 : 0xFFFF);
+        }
+      ramp.tick(); }, false},
+  {"updateChannel(pin, channel)", []() {
+      AD56X4.updateChannel(SS_pin,AD56X4_CHANNEL_ALL); }, false},
+  {"powerUpDown(pin, mode, channels[])", []() {
+      AD56X4.powerUpDown(SS_pin,AD56X4_POWERMODE_NORMAL,
+                         channels); }, false},
+  {"powerUpDown(pin, mode, D, C, B, A)", []() {
+      AD56X4.powerUpDown(SS_pin,AD56X4_POWERMODE_NORMAL,
+                         true,false,true,false); }, false},
+  {"powerUpDown(pin, powerModes[])", []() {
+      AD56X4.powerUpDown(SS_pin,powerModes); }, false},
+  {"powerUpDown(pin, powerModes[]) all same", []() {
+      static const byte same[] = {AD56X4_POWERMODE_TRISTATE,
+                                  AD56X4_POWERMODE_TRISTATE,
+                                  AD56X4_POWERMODE_TRISTATE,
+                                  AD56X4_POWERMODE_TRISTATE};
+      AD56X4.powerUpDown(SS_pin,same); }, false},
+  {"AD56X4PowerManager powerUpDown unchanged", []() {
+      power.powerUpDown(powerModes); }, false},
+  {"reset(pin, fullReset)", []() {
+      AD56X4.reset(SS_pin,true); }, false},
+  {"setInputMode(pin, channels[])", []() {
+      AD56X4.setInputMode(SS_pin,channels); }, false},
+  {"setInputMode(pin, D, C, B, A)", []() {
+      AD56X4.setInputMode(SS_pin,true,false,true,false); }, false},
+  {"useInternalReference(pin, yesno)", []() {
+      AD56X4.useInternalReference(SS_pin,true); }, false},
+  {"setChannel(device, mode, channel, value)", []() {
+      AD56X4.setChannel(dac,AD56X4_SETMODE_INPUT,
+                        AD56X4_CHANNEL_A,values[0]); }, false},
+  {"setChannel(device, mode, values[])", []() {
+      AD56X4.setChannel(dac,AD56X4_SETMODE_INPUT,values); }, false},
+  {"typed setChannel<mode, channel>(device)", []() {
+      AD56X4TypedCommands<AD56X4HardwareSPI>::setChannel<
+        AD56X4SetMode::Input,AD56X4Channel::A>(dac,values[0]); }, false},
+  {"typed setChannel(device, mode, channel)", []() {
+      AD56X4TypedCommands<AD56X4HardwareSPI>::setChannel(dac,
+        AD56X4SetMode::Input,AD56X4Channel::A,values[0]); }, false},
+  {"reset, reference, power, input mode calls", []() {
+      AD56X4.reset(dac,true);
+      AD56X4.useInternalReference(dac,true);
+      AD56X4.powerUpDown(dac,AD56X4_POWERMODE_TRISTATE,0x0C);
+      AD56X4.setInputMode(dac,(byte)0x00); }, false},
+  {"same as preset from flash", []() {
+      AD56X4FrameSender<AD56X4HardwareSPI>::sendPreset(dac,
+                                                       boardInit);
+    }, false},
+  {"setChannel(device, ...) in session", []() {
+      AD56X4.setChannel(dac,AD56X4_SETMODE_INPUT,
+                        AD56X4_CHANNEL_A,values[0]); }, true},
+  {"setChannel(device, values[]) in session", []() {
+      AD56X4.setChannel(dac,AD56X4_SETMODE_INPUT,values); }, true},
+  {"shadow setChannel(values[]) unchanged", []() {
+      shadow.setChannel(AD56X4_SETMODE_INPUT_DAC,values); }, false},
+  {"shadow setChannel(values[]) changed", []() {
+      values[3] ^= 1;
+      shadow.setChannel(AD56X4_SETMODE_INPUT_DAC,values); }, false},
+};
+
+static const int benchmarkCount = sizeof(benchmarks)
+                                  / sizeof(benchmarks[0]);
+
+static double nowNanoseconds ()
+{
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC,&now);
+  return now.tv_sec * 1e9 + now.tv_nsec;
+}
+
+/* Commands whose traces must be the same as what the original
+   library (see AD56X4Original.h) sent for them. commitChannels didn't
+   exist, so it is compared with the four setChannel calls it is.
+*/
+struct TraceComparison
+{
+  const char *name;
+  void (*run) ();
+  void (*original) ();
+  boolean inSession;
+};
+
+static const TraceComparison comparisons[] = {
+  {"setChannel(pin, mode, channel, value)", []() {
+      AD56X4.setChannel(SS_pin,AD56X4_SETMODE_INPUT_DAC,
+                        AD56X4_CHANNEL_B,values[0]); }, []() {
+      AD56X4Original::setChannel(SS_pin,AD56X4_SETMODE_INPUT_DAC,
+                                 AD56X4_CHANNEL_B,values[0]); },
+   false},
+  {"setChannel(pin, mode, values[])", []() {
+      AD56X4.setChannel(SS_pin,AD56X4_SETMODE_INPUT,values); }, []() {
+      AD56X4Original::setChannel(SS_pin,AD56X4_SETMODE_INPUT,values);
+    }, false},
+  {"setChannel(pin, mode, D, C, B, A)", []() {
+      AD56X4.setChannel(SS_pin,AD56X4_SETMODE_INPUT_DAC_ALL,values[0],
+                        values[1],values[2],values[3]); }, []() {
+      AD56X4Original::setChannel(SS_pin,AD56X4_SETMODE_INPUT_DAC_ALL,
+                                 values[0],values[1],values[2],
+                                 values[3]); }, false},
+  {"setChannel(device, mode, values[]) in session", []() {
+      AD56X4.setChannel(dac,AD56X4_SETMODE_INPUT,values); }, []() {
+      AD56X4Original::setChannel(SS_pin,AD56X4_SETMODE_INPUT,values);
+    }, true},
+  {"commitChannels(pin, values[])", []() {
+      AD56X4.commitChannels(SS_pin,values); }, []() {
+      for (int i = 3; i >= 1; i--)
+        AD56X4Original::setChannel(SS_pin,AD56X4_SETMODE_INPUT,i,
+                                   values[3-i]);
+      AD56X4Original::setChannel(SS_pin,AD56X4_SETMODE_INPUT_DAC_ALL,
+                                 AD56X4_CHANNEL_A,values[3]); },
+   false},
+  {"updateChannel(pin, channel)", []() {
+      AD56X4.updateChannel(SS_pin,AD56X4_CHANNEL_ALL); }, []() {
+      AD56X4Original::updateChannel(SS_pin,AD56X4_CHANNEL_ALL); },
+   false},
+  {"powerUpDown(pin, mode, channels[])", []() {
+      AD56X4.powerUpDown(SS_pin,AD56X4_POWERMODE_POWERDOWN_100K,
+                         channels); }, []() {
+      AD56X4Original::powerUpDown(SS_pin,
+                                  AD56X4_POWERMODE_POWERDOWN_100K,
+                                  channels); }, false},
+  {"powerUpDown(pin, mode, D, C, B, A)", []() {
+      AD56X4.powerUpDown(SS_pin,AD56X4_POWERMODE_TRISTATE,true,true,
+                         false,false); }, []() {
+      AD56X4Original::powerUpDown(SS_pin,AD56X4_POWERMODE_TRISTATE,
+                                  true,true,false,false); }, false},
+  {"powerUpDown(pin, powerModes[])", []() {
+      AD56X4.powerUpDown(SS_pin,powerModes); }, []() {
+      AD56X4Original::powerUpDown(SS_pin,powerModes); }, false},
+  {"reset(pin, fullReset)", []() {
+      AD56X4.reset(SS_pin,true); }, []() {
+      AD56X4Original::reset(SS_pin,true); }, false},
+  {"setInputMode(pin, channels[])", []() {
+      AD56X4.setInputMode(SS_pin,channels); }, []() {
+      AD56X4Original::setInputMode(SS_pin,channels); }, false},
+  {"setInputMode(pin, D, C, B, A)", []() {
+      AD56X4.setInputMode(SS_pin,true,false,true,false); }, []() {
+      AD56X4Original::setInputMode(SS_pin,true,false,true,false); },
+   false},
+  {"useInternalReference(pin, yesno)", []() {
+      AD56X4.useInternalReference(SS_pin,true); }, []() {
+      AD56X4Original::useInternalReference(SS_pin,true); }, false},
+};
+
+static const int comparisonCount = sizeof(comparisons)
+                                   / sizeof(comparisons[0]);
+
+/* Returns the printed trace of one call of run (to be freed). */
+static char * traceOf (void (*run) (), boolean inSession)
+{
+  char *text = 0;
+  size_t length = 0;
+  FILE *file = open_memstream(&text,&length);
+  if (inSession)
+    AD56X4.beginSession(dac);
+  AD56X4Host::startTrace();
+  run();
+  AD56X4Host::stopTrace();
+  if (inSession)
+    AD56X4.endSession();
+  AD56X4Host::printTrace(file);
+  fclose(file);
+  return text;
+}
+
+/* Compares the trace of each command with that of the original, and
+   returns the number that differ (printing both).
+*/
+static int compareTraces ()
+{
+  int mismatches = 0;
+  for (int i = 0; i < comparisonCount; i++)
+    {
+      char *trace = traceOf(comparisons[i].run,
+                            comparisons[i].inSession);
+      char *original = traceOf(comparisons[i].original,false);
+      if (strcmp(trace,original) != 0)
+        {
+          mismatches++;
+          printf("%s differs from the original library.\n"
+                 "trace:\n%soriginal:\n%s\n",comparisons[i].name,
+                 trace,original);
+        }
+      free(trace);
+      free(original);
+    }
+  printf("trace comparison: %d of %d commands match the original "
+         "library\n\n",comparisonCount - mismatches,
+         comparisonCount);
+  return mismatches;
+}
+
+static void printTraces ()
+{
+  for (int i = 0; i < benchmarkCount; i++)
+    {
+      printf("%s\n",benchmarks[i].name);
+      if (benchmarks[i].inSession)
+        AD56X4.beginSession(dac);
+      AD56X4Host::startTrace();
+      benchmarks[i].run();
+      AD56X4Host::stopTrace();
+      if (benchmarks[i].inSession)
+        AD56X4.endSession();
+      AD56X4Host::printTrace(stdout);
+      printf("\n");
+    }
+}
+
+static void runBenchmarks (unsigned long iterations)
+{
+  printf("%-42s %7s %7s %7s %8s %9s\n","call","frames","setups",
+         "clocks","cycles","ns/call");
+  
+  for (int i = 0; i < benchmarkCount; i++)
+    {
+      if (benchmarks[i].inSession)
+        AD56X4.beginSession(dac);
+      AD56X4Host::clear();
+      
+      double start = nowNanoseconds();
+      for (unsigned long n = 0; n < iterations; n++)
+        benchmarks[i].run();
+      double elapsed = nowNanoseconds() - start;
+      
+      if (benchmarks[i].inSession)
+        AD56X4.endSession();
+      
+      double perCall = 1.0 / iterations;
+      printf("%-42s %7.2f %7.2f %7.1f %8.1f %9.1f\n",
+             benchmarks[i].name,AD56X4Host::frames * perCall,
+             AD56X4Host::spiSetups * perCall,
+             AD56X4Host::busClocks * perCall,
+             AD56X4Host::shiftCycles * perCall,elapsed * perCall);
+    }
+}
+
+/* Full refreshes of banks of 1 to AD56X4_BANK_SIZE chips (every
+   channel a different value), with the refresh rate the bus time
+   allows on a 16 MHz AVR.
+*/
+static void runBankBenchmarks (unsigned long iterations)
+{
+  AD56X4Device chips[] = {2, 3, 4, 5, 6, 7, 8, 9};
+  word bankValues[4 * AD56X4_BANK_SIZE];
+  for (int i = 0; i < 4 * AD56X4_BANK_SIZE; i++)
+    bankValues[i] = 0x1000 + i;
+  
+  printf("\n%-6s %9s %9s %9s %12s %9s\n","chips","frames","setups",
+         "cycles","refresh Hz","ns/call");
+  
+  for (byte n = 1; n <= AD56X4_BANK_SIZE; n *= 2)
+    {
+      AD56X4Bank<AD56X4HardwareSPI> bank(chips,n);
+      AD56X4Host::clear();
+      
+      double start = nowNanoseconds();
+      for (unsigned long k = 0; k < iterations; k++)
+        bank.update(bankValues);
+      double elapsed = nowNanoseconds() - start;
+      
+      double perCall = 1.0 / iterations;
+      double cycles = AD56X4Host::shiftCycles * perCall;
+      printf("%-6d %9.2f %9.2f %9.1f %12.0f %9.1f\n",n,
+             AD56X4Host::frames * perCall,
+             AD56X4Host::spiSetups * perCall,cycles,16e6 / cycles,
+             elapsed * perCall);
+    }
+}
+
+/* Ticks of the sample clock with the samples coming from dds, with
+   the sample rate the bus time allows on a 16 MHz AVR.
+*/
+static void nextSample (word samples[])
+{
+  dds.step();
+  dds.samples(samples);
+}
+static void runSampleClockBenchmark (unsigned long iterations)
+{
+  printf("\n%-14s %9s %9s %9s %12s %9s\n","sample clock","frames",
+         "setups","cycles","max rate Hz","ns/tick");
+  
+  AD56X4SampleClock.begin(dac,nextSample);
+  AD56X4Host::clear();
+  
+  double start = nowNanoseconds();
+  for (unsigned long k = 0; k < iterations; k++)
+    AD56X4SampleClock.tick();
+  double elapsed = nowNanoseconds() - start;
+  
+  AD56X4SampleClock.end();
+  
+  double perCall = 1.0 / iterations;
+  double cycles = AD56X4Host::shiftCycles * perCall;
+  printf("%-14s %9.2f %9.2f %9.1f %12.0f %9.1f\n","tick",
+         AD56X4Host::frames * perCall,AD56X4Host::spiSetups * perCall,
+         cycles,16e6 / cycles,elapsed * perCall);
+}
+
+int main (int argc, char *argv[])
+{
+  voltage.useExternalReference(5000);
+  ramp.setRate(AD56X4_CHANNEL_ALL,64);
+  for (int i = 0; i < 4; i++)
+    {
+      dds.setFrequency(i,10000);
+      dds.setPhase(i,i * 0x4000);
+      dds.setAmplitude(i,32600);
+      dds.setOffset(i,32768);
+      player.setTable(i,staircase,sizeof(staircase) / sizeof(word));
+      player.setLoop(i,0,sizeof(staircase) / sizeof(word));
+      player.setRate(i,1,i + 1);
+    }
+  for (int i = 0; i < 4; i++)
+    calibration.set(3 - i,
+                    (uint16_t)(gains[i] * AD56X4_CALIBRATION_UNITY),
+                    (int16_t)offsets[i]);
+  
+  SPI.setClockDivider(SPI_CLOCK_DIV2);
+  SPI.begin();
+  
+  if (argc > 1 && strcmp(argv[1],"-t") == 0)
+    printTraces();
+  else if (compareTraces() != 0)
+    return 1;
+  else if (argc > 1 && strcmp(argv[1],"-c") == 0)
+    return 0;
+  else
+    {
+      unsigned long iterations = argc > 1 ? strtoul(argv[1],0,10)
+                                 : 1000000;
+      runBenchmarks(iterations);
+      runBankBenchmarks(iterations / 10);
+      runSampleClockBenchmark(iterations);
+    }
+  
+  return 0;
+}
@@ -0,0 +1,682 @@
+/* Copyright (c) 2026, Freja Nordsiek
+   All rights reserved.
+   
+   Redistribution and use in source and binary forms, with or
+   without modification, are permitted provided that the
+   following conditions are met:
+   
+   1. Redistributions of source code must retain the above
+   copyright notice, this list of conditions and the following disclaimer.
+   
+   2. Redistributions in binary form must reproduce the above
+   copyright notice, this list of conditions and the following
+   disclaimer in the documentation and/or other materials
+   provided with the distribution.
+   
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+   NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+   LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+   HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+   OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*
+   frametest.cpp: Tests of the messages (frames) the command layer
+                  and the objects built on it send, recorded with
+                  AD56X4RecordingBus and checked against the
+                  expected frames, plus the values of the objects
+                  that only work them out.
+   
+   Author:   Freja Nordsiek
+   Notes:    Host builds only. Not part of the Arduino library.
+             Build and run with "make check".
+   History:  * 2026-10-16 Created.
+*/
+
+/* A frame is recorded as header << 16 | data, so 0x100004 is channel
+   A's input register set to 4 with all the DAC registers updated.
+   Every check that fails is printed, and the exit status is 1 if
+   any did. Each object has its own test function, called from main,
+   so a new object's tests go in with it.
+*/
+
+#include <stdio.h>
+#include "Arduino.h"
+#include <AD56X4Commands.h>
+#include <AD56X4Shadow.h>
+#include <AD56X4Chip.h>
+#include <AD56X4Plan.h>
+#include <AD56X4Power.h>
+#include <AD56X4Bank.h>
+#include <AD56X4Calibration.h>
+#include <AD56X4Voltage.h>
+#include <AD56X4DDS.h>
+#include <AD56X4Wave.h>
+#include <AD56X4Ramp.h>
+#include <AD56X4Typed.h>
+#include <AD56X4Frame.h>
+#include <AD56X4SampleClock.h>
+#include "AD56X4Host.h"
+
+typedef AD56X4RecordingBus Recorder;
+typedef AD56X4Commands<Recorder> Commands;
+
+static int checks = 0;
+static int failures = 0;
+
+static unsigned long frames[32];
+static Recorder bus(frames,32);
+
+/* Checks that the frames recorded on recorder since the last check
+   are expected (count of them), and starts recording afresh.
+*/
+static void expect (Recorder &recorder, const char *name,
+                    const unsigned long expected[], unsigned int count)
+{
+  checks++;
+  boolean same = recorder.count == count;
+  for (unsigned int i = 0; same && i < count; i++)
+    same = recorder.frames[i] == expected[i];
+  if (!same)
+    {
+      failures++;
+      printf("frametest: %s: expected", name);
+      for (unsigned int i = 0; i < count; i++)
+        printf(" %06lx",expected[i]);
+      printf(", got");
+      for (unsigned int i = 0; i < recorder.count && i < recorder.size;
+           i++)
+        printf(" %06lx",recorder.frames[i]);
+      printf("\n");
+    }
+  recorder.count = 0;
+}
+
+#define EXPECT(recorder, name, ...)                                  \
+  do                                                                 \
+    {                                                                \
+      const unsigned long expected[] = {__VA_ARGS__};                \
+      expect(recorder,name,expected,                                 \
+             sizeof(expected) / sizeof(expected[0]));                \
+    }                                                                \
+  while (0)
+
+#define EXPECT_NONE(recorder, name) expect(recorder,name,0,0)
+
+/* Checks a value worked out by an object. */
+static void check (const char *name, unsigned long got,
+                   unsigned long expected)
+{
+  checks++;
+  if (got != expected)
+    {
+      failures++;
+      printf("frametest: %s: expected %lu, got %lu\n",name,expected,
+             got);
+    }
+}
+
+static void testCommands ()
+{
+  
+  word values[] = {1, 2, 3, 4};
+  Commands::commitChannels(bus,values);
+  EXPECT(bus,"commitChannels",0x030001,0x020002,0x010003,0x100004);
+  Commands::commitChannels(bus,5,5,5,5);
+  EXPECT(bus,"commitChannels same",0x170005);
+  
+  // makeCommitMessages takes the values in channel order.
+  
+  word channelValues[] = {10, 20, 30, 40};
+  byte headers[4];
+  word data[4];
+  byte count = Commands::makeCommitMessages(channelValues,0x06,
+                                            AD56X4_SETMODE_INPUT_DAC,
+                                            headers,data);
+  Recorder::writeMessages(bus,headers,data,count);
+  EXPECT(bus,"makeCommitMessages two",0x02001e,0x110014);
+  count = Commands::makeCommitMessages(channelValues,0x04,
+                                       AD56X4_SETMODE_INPUT_DAC,
+                                       headers,data);
+  Recorder::writeMessages(bus,headers,data,count);
+  EXPECT(bus,"makeCommitMessages one",0x1a001e);
+  count = Commands::makeCommitMessages(channelValues,0x05,
+                                       AD56X4_SETMODE_INPUT,
+                                       headers,data);
+  Recorder::writeMessages(bus,headers,data,count);
+  EXPECT(bus,"makeCommitMessages input",0x02001e,0x00000a);
+  check("makeCommitMessages none",
+        Commands::makeCommitMessages(channelValues,0,
+                                     AD56X4_SETMODE_INPUT_DAC_ALL,
+                                     headers,data),0);
+  
+  byte powerModes[] = {AD56X4_POWERMODE_NORMAL,
+                       AD56X4_POWERMODE_TRISTATE,
+                       AD56X4_POWERMODE_NORMAL,
+                       AD56X4_POWERMODE_TRISTATE};
+  Commands::powerUpDown(bus,powerModes);
+  EXPECT(bus,"powerUpDown grouped",0x200005,0x20003a);
+  
+}
+
+/* The chip's values are shifted up to 16 bits, and values above its
+   full scale are clamped to it rather than wrapping around.
+*/
+static void testChip ()
+{
+  
+  typedef AD56X4Chip<AD5644R,Recorder> Chip14;
+  typedef AD56X4Chip<AD5624,Recorder> Chip12;
+  typedef AD56X4Chip<AD5664R,Recorder> Chip16;
+  
+  static_assert(Chip14::toWord(Chip14::fullScale) == 0xfffc,
+                "AD5644R full scale");
+  static_assert(Chip14::toWord(0x4000) == 0xfffc,
+                "AD5644R clamp");
+  static_assert(Chip12::toWord(0xffff) == 0xfff0, "AD5624 clamp");
+  static_assert(Chip16::toWord(0xffff) == 0xffff, "AD5664R full");
+  
+  Chip14::setChannel(bus,AD56X4_SETMODE_INPUT_DAC,AD56X4_CHANNEL_A,
+                     0x2000);
+  Chip14::setChannel(bus,AD56X4_SETMODE_INPUT_DAC,AD56X4_CHANNEL_B,
+                     0x4000);
+  EXPECT(bus,"chip setChannel",0x188000,0x19fffc);
+  
+  word values[] = {0x0fff, 0x1000, 0x8000, 1};
+  Chip12::setChannel(bus,AD56X4_SETMODE_INPUT,values);
+  EXPECT(bus,"chip setChannel values",0x03fff0,0x02fff0,0x01fff0,
+         0x000010);
+  Chip12::setChannel(bus,AD56X4_SETMODE_INPUT,0x1000,0,0x0fff,2);
+  EXPECT(bus,"chip setChannel four",0x03fff0,0x020000,0x01fff0,
+         0x000020);
+  
+  Chip14::commitChannels(bus,0x3fff,0x4000,0,1);
+  EXPECT(bus,"chip commitChannels",0x03fffc,0x02fffc,0x010000,
+         0x100004);
+  Chip14::commitChannels(bus,values);
+  EXPECT(bus,"chip commitChannels values",0x033ffc,0x024000,
+         0x01fffc,0x100004);
+  
+}
+
+static void testShadow ()
+{
+  
+  AD56X4Shadow<Recorder> shadow(bus);
+  
+  // Everything is unknown to begin with, so it is all sent.
+  
+  shadow.setChannel(AD56X4_SETMODE_INPUT,AD56X4_CHANNEL_B,0);
+  EXPECT(bus,"shadow unknown",0x010000);
+  
+  shadow.reset(true);
+  EXPECT(bus,"shadow reset",0x280001);
+  check("shadow known",shadow.known(),true);
+  
+  shadow.setChannel(AD56X4_SETMODE_INPUT_DAC,AD56X4_CHANNEL_A,100);
+  shadow.setChannel(AD56X4_SETMODE_INPUT_DAC,AD56X4_CHANNEL_A,100);
+  EXPECT(bus,"shadow redundant",0x180064);
+  shadow.setChannel(AD56X4_SETMODE_INPUT_DAC,AD56X4_CHANNEL_A,100,
+                    AD56X4_FORCE);
+  EXPECT(bus,"shadow forced",0x180064);
+  
+  shadow.powerUpDown(AD56X4_POWERMODE_NORMAL,0x0F);
+  EXPECT_NONE(bus,"shadow powered up");
+  shadow.powerUpDown(AD56X4_POWERMODE_POWERDOWN_1K,0x0C);
+  EXPECT(bus,"shadow power down",0x20001c);
+  
+  // commitChannels skips the input registers that are already set,
+  // but sends the last message if any output changes.
+  
+  shadow.commitChannels(0,0,0,100);
+  EXPECT_NONE(bus,"shadow commit unchanged");
+  shadow.commitChannels(7,0,0,100);
+  EXPECT(bus,"shadow commit",0x030007,0x100064);
+  check("shadow dacRegister",shadow.dacRegister(AD56X4_CHANNEL_D),7);
+  
+  check("shadow framesSent",shadow.framesSent,7);
+  check("shadow framesSuppressed",shadow.framesSuppressed,8);
+  
+}
+
+static void testPlan ()
+{
+  
+  AD56X4Plan plan;
+  plan.setChannel(AD56X4_CHANNEL_A,1000);
+  plan.setChannel(AD56X4_CHANNEL_B,1000);
+  plan.powerUpDown(AD56X4_POWERMODE_TRISTATE,0x0C);
+  plan.send<Recorder>(bus);
+  EXPECT(bus,"plan",0x20003c,0x0103e8,0x1003e8);
+  
+  // Three channels sharing a value are written at once first.
+  
+  plan.clear();
+  plan.useInternalReference(true);
+  word values[] = {9, 5, 5, 5};
+  plan.setChannel(values);
+  plan.setInputMode(0x0F);
+  plan.send<Recorder>(bus);
+  EXPECT(bus,"plan common",0x380001,0x070005,0x130009,0x30000f);
+  
+  plan.clear();
+  plan.setChannel(AD56X4_CHANNEL_ALL,5);
+  plan.send<Recorder>(bus);
+  EXPECT(bus,"plan same",0x1f0005);
+  
+  // Values are written before powering up, so the channel comes up
+  // at its new value.
+  
+  plan.clear();
+  plan.powerUpDown(AD56X4_POWERMODE_NORMAL,0x02);
+  plan.setChannel(AD56X4_CHANNEL_B,7);
+  plan.send<Recorder>(bus);
+  EXPECT(bus,"plan power up",0x190007,0x200002);
+  
+}
+
+static void testPowerManager ()
+{
+  
+  AD56X4PowerManager<Recorder> power(bus);
+  
+  byte modes[] = {AD56X4_POWERMODE_NORMAL, AD56X4_POWERMODE_NORMAL,
+                  AD56X4_POWERMODE_TRISTATE,
+                  AD56X4_POWERMODE_TRISTATE};
+  power.powerUpDown(modes);
+  EXPECT(bus,"power first",0x200003,0x20003c);
+  power.powerUpDown(AD56X4_POWERMODE_TRISTATE,0x0C);
+  EXPECT_NONE(bus,"power unchanged");
+  
+  // B goes idle and is powered back up after its next write.
+  
+  power.setIdlePowerDown(20,AD56X4_POWERMODE_POWERDOWN_1K);
+  delay(30);
+  power.setChannel(AD56X4_SETMODE_INPUT_DAC,AD56X4_CHANNEL_A,7);
+  power.update();
+  EXPECT(bus,"power idle",0x180007,0x200012);
+  check("power idleChannels",power.idleChannels(),0x02);
+  check("power powerMode",power.powerMode(AD56X4_CHANNEL_B),
+        AD56X4_POWERMODE_POWERDOWN_1K);
+  
+  power.powerUpDown(AD56X4_POWERMODE_NORMAL,0x03);
+  EXPECT_NONE(bus,"power idle stays idle");
+  
+  power.setChannel(AD56X4_SETMODE_INPUT_DAC,AD56X4_CHANNEL_B,9);
+  EXPECT(bus,"power wake",0x190009,0x200002);
+  check("power woken",power.idleChannels(),0);
+  power.waitReady();
+  
+  word zeros[] = {0, 0, 0, 0};
+  power.commitChannels(zeros);
+  EXPECT(bus,"power commit",0x170000);
+  
+}
+
+static void testBank ()
+{
+  
+  unsigned long frames0[8];
+  unsigned long frames1[8];
+  Recorder chips[] = {Recorder(frames0,8), Recorder(frames1,8)};
+  AD56X4Bank<Recorder> bank(chips,2);
+  check("bank channels",bank.channels(),8);
+  
+  bank.stage(1,100);
+  bank.stage(6,200);
+  bank.stage(7,300);
+  bank.commit();
+  EXPECT(chips[0],"bank single",0x190064);
+  EXPECT(chips[1],"bank two",0x03012c,0x1200c8);
+  
+  bank.commit();
+  EXPECT_NONE(chips[0],"bank unstaged");
+  
+  word values[] = {5, 5, 5, 5, 1, 2, 3, 4};
+  bank.stage(values);
+  bank.commit();
+  EXPECT(chips[0],"bank same",0x1f0005);
+  EXPECT(chips[1],"bank all",0x030004,0x020003,0x010002,0x100001);
+  
+  bank.stage(2,9);
+  bank.commit(false);
+  EXPECT(chips[0],"bank input only",0x020009);
+  
+}
+
+static void testCalibration ()
+{
+  
+  AD56X4Calibration calibration;
+  calibration.set(AD56X4_CHANNEL_A,AD56X4_CALIBRATION_UNITY,-12,0,
+                  65000);
+  calibration.set(AD56X4_CHANNEL_B,AD56X4_CALIBRATION_UNITY / 2,0);
+  calibration.set(AD56X4_CHANNEL_C,0xFFFF,0,0,60000);
+  
+  check("calibration offset",
+        calibration.apply(AD56X4_CHANNEL_A,1000),988);
+  check("calibration floor",calibration.apply(AD56X4_CHANNEL_A,5),0);
+  check("calibration gain",calibration.apply(AD56X4_CHANNEL_B,1001),
+        501);
+  check("calibration maximum",
+        calibration.apply(AD56X4_CHANNEL_C,40000),60000);
+  
+  word values[] = {100, 40000, 1001, 1000};
+  word calibrated[4];
+  calibration.applyAll(values,calibrated);
+  Commands::commitChannels(bus,calibrated);
+  EXPECT(bus,"calibration commit",0x030064,0x02ea60,0x0101f5,
+         0x1003dc);
+  
+}
+
+static void testVoltage ()
+{
+  
+  AD56X4Voltage<AD5644R,Recorder> voltage(bus);
+  
+  // With no reference set, every voltage is zero, even the largest.
+  
+  voltage.setVoltage(AD56X4_SETMODE_INPUT_DAC,AD56X4_CHANNEL_A,0xFFFF);
+  voltage.setVoltage(AD56X4_SETMODE_INPUT_DAC,AD56X4_CHANNEL_B,1000);
+  EXPECT(bus,"voltage no reference",0x180000,0x190000);
+  
+  voltage.useInternalReference(AD56X4_INTERNAL_REFERENCE_3);
+  check("voltage fullScale",voltage.fullScaleMillivolts(),2500);
+  voltage.setVoltage(AD56X4_SETMODE_INPUT_DAC,AD56X4_CHANNEL_A,1250);
+  voltage.setVoltage(AD56X4_SETMODE_INPUT_DAC,AD56X4_CHANNEL_A,3000);
+  EXPECT(bus,"voltage internal",0x380001,0x188000,0x18fffc);
+  
+  voltage.useExternalReference(5000);
+  voltage.setVoltage(AD56X4_SETMODE_INPUT_DAC,AD56X4_CHANNEL_B,1000);
+  EXPECT(bus,"voltage external",0x380000,0x193334);
+  
+  word millivolts[] = {5000, 5000, 5000, 5000};
+  voltage.commitVoltages(millivolts);
+  EXPECT(bus,"voltage commit",0x17fffc);
+  
+}
+
+static void testDDS ()
+{
+  
+  // A quarter of a cycle per tick, so the samples go through the
+  // peaks and zero crossings of the table.
+  
+  AD56X4DDS dds(1000);
+  dds.setFrequency(AD56X4_CHANNEL_A,250000);
+  check("dds tuningWord",dds.tuningWord(AD56X4_CHANNEL_A),
+        0x40000000UL);
+  dds.setAmplitude(AD56X4_CHANNEL_A,1000);
+  dds.setOffset(AD56X4_CHANNEL_A,32768);
+  
+  const unsigned long expected[] = {32768, 33767, 32768, 31768};
+  for (byte i = 0; i < 4; i++)
+    {
+      check("dds sample",dds.sample(AD56X4_CHANNEL_A),expected[i]);
+      dds.step();
+    }
+  
+  // A quarter cycle of phase offset, and saturation.
+  
+  dds.restart();
+  dds.setAmplitude(AD56X4_CHANNEL_B,32767);
+  dds.setOffset(AD56X4_CHANNEL_B,40000);
+  dds.setPhase(AD56X4_CHANNEL_B,0x4000);
+  check("dds phase",dds.sample(AD56X4_CHANNEL_B),65535);
+  
+  word values[4];
+  dds.samples(values);
+  Commands::commitChannels(bus,values);
+  EXPECT(bus,"dds commit",0x030000,0x020000,0x01ffff,0x108000);
+  
+}
+
+static const word waveTable[] PROGMEM = {10, 20, 30, 40};
+
+static void testWavePlayer ()
+{
+  
+  AD56X4WavePlayer player;
+  player.setTable(AD56X4_CHANNEL_A,waveTable,4);
+  player.setTable(AD56X4_CHANNEL_B,waveTable,4);
+  player.setLoop(AD56X4_CHANNEL_B,1,3);
+  player.setTable(AD56X4_CHANNEL_C,waveTable,4);
+  player.setRate(AD56X4_CHANNEL_C,1,2);
+  
+  const unsigned long once[] = {10, 20, 30, 40, 40};
+  const unsigned long loop[] = {10, 20, 30, 20, 30};
+  const unsigned long half[] = {10, 10, 20, 20, 30};
+  for (byte i = 0; i < 5; i++)
+    {
+      check("wave once",player.sample(AD56X4_CHANNEL_A),once[i]);
+      check("wave loop",player.sample(AD56X4_CHANNEL_B),loop[i]);
+      check("wave half",player.sample(AD56X4_CHANNEL_C),half[i]);
+      check("wave none",player.sample(AD56X4_CHANNEL_D),0);
+      if (i == 2)
+        {
+          player.commit<Recorder>(bus);
+          EXPECT(bus,"wave commit",0x030000,0x020014,0x01001e,
+                 0x10001e);
+        }
+      player.step();
+    }
+  check("wave done",player.playing(AD56X4_CHANNEL_A),false);
+  check("wave looping",player.playing(AD56X4_CHANNEL_B),true);
+  
+}
+
+static void testRamp ()
+{
+  
+  AD56X4Ramp<Recorder> ramp(bus);
+  ramp.setRate(AD56X4_CHANNEL_ALL,100);
+  
+  ramp.setTarget(AD56X4_CHANNEL_A,250);
+  check("ramp tick",ramp.tick(),0x01);
+  ramp.tick();
+  ramp.tick();
+  EXPECT(bus,"ramp single",0x180064,0x1800c8,0x1800fa);
+  check("ramp done",ramp.tick(),0);
+  EXPECT_NONE(bus,"ramp idle");
+  
+  ramp.setTarget(AD56X4_CHANNEL_B,50);
+  ramp.setTarget(AD56X4_CHANNEL_C,50);
+  check("ramp two",ramp.tick(),0x06);
+  EXPECT(bus,"ramp two",0x020032,0x110032);
+  
+  ramp.jump(AD56X4_CHANNEL_ALL,7);
+  EXPECT(bus,"ramp jump",0x1f0007);
+  
+  ramp.jump(9,5);
+  ramp.jump(5,5);
+  EXPECT_NONE(bus,"ramp jump bad channel");
+  ramp.setTarget(5,9);
+  check("ramp bad channel value",ramp.value(AD56X4_CHANNEL_B),7);
+  check("ramp bad channel target",ramp.targetValue(AD56X4_CHANNEL_B),7);
+  
+  ramp.setTarget(AD56X4_CHANNEL_ALL,1000);
+  check("ramp all",ramp.tick(),0x0f);
+  EXPECT(bus,"ramp all same",0x1f006b);
+  check("ramp ramping",ramp.ramping(),true);
+  
+}
+
+static void testTyped ()
+{
+  
+  typedef AD56X4TypedCommands<Recorder> Typed;
+  
+  // The headers are constants, and the same as the untyped ones.
+  
+  static_assert(Typed::makeHeader(AD56X4SetMode::InputDAC,
+                                  AD56X4Channel::B) == 0x19,
+                "typed header");
+  static_assert(Typed::makePowerData(AD56X4PowerMode::TriState,
+                                     AD56X4Channel::C
+                                     | AD56X4Channel::D) == 0x3C,
+                "typed power data");
+  
+  Typed::setChannel<AD56X4SetMode::InputDAC,AD56X4Channel::A>(bus,
+                                                               0x1234);
+  Typed::setChannel(bus,AD56X4SetMode::InputDACAll,AD56X4Channel::C,5);
+  EXPECT(bus,"typed setChannel",0x181234,0x120005);
+  
+  word values[] = {1, 2, 3, 4};
+  Typed::setChannel(bus,AD56X4SetMode::Input,values);
+  EXPECT(bus,"typed setChannel values",0x030001,0x020002,0x010003,
+         0x000004);
+  
+  Typed::updateChannel<AD56X4Channel::All>(bus);
+  Typed::updateChannel(bus,AD56X4Channel::B);
+  EXPECT(bus,"typed updateChannel",0x0f0000,0x090000);
+  
+  Typed::powerUpDown(bus,AD56X4PowerMode::PowerDown1K,
+                     AD56X4Channel::All);
+  EXPECT(bus,"typed powerUpDown",0x20001f);
+  
+  // An empty mask, and one built up with |=.
+  
+  AD56X4ChannelMask channels;
+  Typed::setInputMode(bus,channels);
+  channels |= AD56X4Channel::A;
+  channels |= AD56X4Channel::D;
+  Typed::setInputMode(bus,channels);
+  EXPECT(bus,"typed setInputMode",0x300000,0x300009);
+  
+  Typed::reset(bus,true);
+  Typed::useInternalReference(bus,true);
+  EXPECT(bus,"typed reset and reference",0x280001,0x380001);
+  
+}
+
+// A preset longer than a burst (AD56X4_FRAME_BURST frames).
+
+static const AD56X4Frame preset[] PROGMEM = {
+  AD56X4Frame::reset(true),
+  AD56X4Frame::useInternalReference(true),
+  AD56X4Frame::powerUpDown(AD56X4_POWERMODE_TRISTATE,0x0C),
+  AD56X4Frame::setInputMode(0x00),
+  AD56X4Frame::setChannel(AD56X4_SETMODE_INPUT,AD56X4_CHANNEL_D,1),
+  AD56X4Frame::setChannel(AD56X4_SETMODE_INPUT,AD56X4_CHANNEL_C,2),
+  AD56X4Frame::setChannel(AD56X4_SETMODE_INPUT,AD56X4_CHANNEL_B,3),
+  AD56X4Frame::setChannel(AD56X4_SETMODE_INPUT,AD56X4_CHANNEL_A,4),
+  AD56X4Frame::updateChannel(AD56X4_CHANNEL_ALL)
+};
+
+static void testFrame ()
+{
+  
+  typedef AD56X4FrameSender<Recorder> Sender;
+  
+  // Frames are constants, with the same headers as the commands
+  // (out of range fields are masked off the same way).
+  
+  static_assert(AD56X4Frame::setChannel(AD56X4_SETMODE_INPUT_DAC,
+                                        AD56X4_CHANNEL_B,0).header
+                == 0x19,"frame header");
+  static_assert(AD56X4Frame::make(0xFF,0xFF,0).header
+                == Commands::makeHeader(0xFF,0xFF),"frame masking");
+  
+  // Each frame is the message its command sends.
+  
+  Commands::setChannel(bus,AD56X4_SETMODE_INPUT_DAC_ALL,
+                       AD56X4_CHANNEL_C,0x1234);
+  Commands::updateChannel(bus,AD56X4_CHANNEL_B);
+  Commands::powerUpDown(bus,AD56X4_POWERMODE_POWERDOWN_1K,
+                        (byte)0x05);
+  Commands::reset(bus,false);
+  Commands::setInputMode(bus,(byte)0x0A);
+  Commands::useInternalReference(bus,true);
+  unsigned long fromCommands[6];
+  for (byte i = 0; i < 6; i++)
+    fromCommands[i] = bus.frames[i];
+  bus.count = 0;
+  
+  Sender::sendFrame(bus,AD56X4Frame::setChannel(
+                      AD56X4_SETMODE_INPUT_DAC_ALL,AD56X4_CHANNEL_C,
+                      0x1234));
+  Sender::sendFrame(bus,AD56X4Frame::updateChannel(AD56X4_CHANNEL_B));
+  Sender::sendFrame(bus,AD56X4Frame::powerUpDown(
+                      AD56X4_POWERMODE_POWERDOWN_1K,0x05));
+  Sender::sendFrame(bus,AD56X4Frame::reset(false));
+  Sender::sendFrame(bus,AD56X4Frame::setInputMode(0x0A));
+  Sender::sendFrame(bus,AD56X4Frame::useInternalReference(true));
+  expect(bus,"frames as commands",fromCommands,6);
+  
+  // A frame in flash, and a preset sent in two bursts.
+  
+  Sender::sendFrame_P(bus,&preset[3]);
+  EXPECT(bus,"frame from flash",0x300000);
+  Sender::sendPreset(bus,preset);
+  EXPECT(bus,"preset",0x280001,0x380001,0x20003c,0x300000,0x030001,
+         0x020002,0x010003,0x000004,0x0f0000);
+  
+}
+
+/* The sample clock goes through the hardware bus, so its frames are
+   counted by the host recorder rather than recorded here. The timer
+   isn't there on the host, so only tick's bookkeeping is checked.
+*/
+static word clockSample = 0;
+
+static void nextClockSample (word values[])
+{
+  for (byte i = 0; i < 4; i++)
+    values[i] = clockSample;
+  clockSample++;
+}
+
+static void testSampleClock ()
+{
+  static const AD56X4Device device(10);
+  
+  AD56X4Host::clear();
+  AD56X4SampleClock.begin(device,nextClockSample);
+  check("clock begin frames",AD56X4Host::frames,4);
+  check("clock begin samples",AD56X4SampleClock.samples(),0);
+  
+  AD56X4SampleClock.tick();
+  AD56X4SampleClock.tick();
+  check("clock tick frames",AD56X4Host::frames,4 + 2 * 5);
+  check("clock tick samples",AD56X4SampleClock.samples(),2);
+  check("clock producer calls",clockSample,3);
+  check("clock overruns",AD56X4SampleClock.overruns(),0);
+  check("clock not started",AD56X4SampleClock.start(1000),0);
+  
+  AD56X4SampleClock.clearStatistics();
+  check("clock cleared samples",AD56X4SampleClock.samples(),0);
+  AD56X4SampleClock.end();
+}
+
+int main ()
+{
+  
+  testCommands();
+  testChip();
+  testShadow();
+  testPlan();
+  testPowerManager();
+  testBank();
+  testCalibration();
+  testVoltage();
+  testDDS();
+  testWavePlayer();
+  testRamp();
+  testTyped();
+  testFrame();
+  testSampleClock();
+  
+  printf("frametest: %d checks, %d failed\n",checks,failures);
+  puts(failures == 0 ? "frametest: passed" : "frametest: FAILED");
+  return failures == 0 ? 0 : 1;
+  
+}
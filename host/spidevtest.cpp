@@ -0,0 +1,281 @@
+/* Copyright (c) 2026, Freja Nordsiek
+   All rights reserved.
+   
+   Redistribution and use in source and binary forms, with or
+   without modification, are permitted provided that the
+   following conditions are met:
+   
+   1. Redistributions of source code must retain the above
+   copyright notice, this list of conditions and the following disclaimer.
+   
+   2. Redistributions in binary form must reproduce the above
+   copyright notice, this list of conditions and the following
+   disclaimer in the documentation and/or other materials
+   provided with the distribution.
+   
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+   NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+   LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+   HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+   OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*
+   spidevtest.cpp: Test of the AD56X4Spidev bus (see AD56X4Spidev.h)
+                   with a stand-in for ioctl() that records the SPI
+                   messages instead of sending them.
+   
+   Author:   Freja Nordsiek
+   Notes:    Linux host builds only. Not part of the Arduino library.
+             Build and run with "make check".
+   History:  * 2026-10-16 Created.
+*/
+
+/* The bus is opened on /dev/null, and every ioctl() it makes comes
+   here instead of going to the kernel (the definition below takes
+   the place of the C library's). The setup ioctls are checked when
+   opening, and each SPI_IOC_MESSAGE is recorded (its transfers and
+   the bytes they point to), which are then checked for one ioctl
+   per burst or batch, 3 bytes a message, cs_change on every
+   transfer but the last, and the collected messages being sent when
+   AD56X4_SPIDEV_BATCH of them have been. The bus not being copyable
+   (it owns the file descriptor) is checked too. Every check that
+   fails is printed, and the exit status is 1 if any did.
+*/
+
+#include <errno.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <type_traits>
+#include "AD56X4Spidev.h"
+
+static int checks = 0;
+static int failures = 0;
+
+/* Checks a value, printing it if it isn't the expected one. */
+static void check (const char *name, unsigned long got,
+                   unsigned long expected)
+{
+  checks++;
+  if (got != expected)
+    {
+      failures++;
+      printf("spidevtest: %s: expected %lu, got %lu\n",name,expected,
+             got);
+    }
+}
+
+// What the stand-in ioctl recorded: the setup values, and the
+// messages of the last few SPI_IOC_MESSAGE calls.
+
+#define MAX_CALLS 4
+#define MAX_TRANSFERS (2 * AD56X4_SPIDEV_BATCH)
+
+struct Call
+{
+  unsigned int count;
+  struct spi_ioc_transfer transfers[MAX_TRANSFERS];
+  uint8_t bytes[MAX_TRANSFERS][3];
+};
+
+static uint8_t mode = 0xFF;
+static uint8_t lsbFirst = 0xFF;
+static uint8_t bitsPerWord = 0;
+static uint32_t maxSpeed = 0;
+static int failWith = 0;
+static unsigned int calls = 0;
+static Call recorded[MAX_CALLS];
+
+extern "C" int ioctl (int fd, unsigned long request, ...)
+{
+  
+  va_list arguments;
+  va_start(arguments,request);
+  void *argument = va_arg(arguments,void *);
+  va_end(arguments);
+  
+  (void)fd;
+  
+  if (failWith != 0)
+    {
+      errno = failWith;
+      return -1;
+    }
+  
+  if (request == SPI_IOC_WR_MODE)
+    mode = *(uint8_t *)argument;
+  else if (request == SPI_IOC_WR_LSB_FIRST)
+    lsbFirst = *(uint8_t *)argument;
+  else if (request == SPI_IOC_WR_BITS_PER_WORD)
+    bitsPerWord = *(uint8_t *)argument;
+  else if (request == SPI_IOC_WR_MAX_SPEED_HZ)
+    maxSpeed = *(uint32_t *)argument;
+  else if (_IOC_TYPE(request) == SPI_IOC_MAGIC && _IOC_NR(request) == 0
+           && _IOC_DIR(request) == _IOC_WRITE)
+    {
+      unsigned int count = _IOC_SIZE(request)
+                           / sizeof(struct spi_ioc_transfer);
+      if (count > MAX_TRANSFERS)
+        {
+          errno = EINVAL;
+          return -1;
+        }
+      Call &call = recorded[calls % MAX_CALLS];
+      const struct spi_ioc_transfer *transfers =
+        (const struct spi_ioc_transfer *)argument;
+      call.count = count;
+      for (unsigned int i = 0; i < count; i++)
+        {
+          call.transfers[i] = transfers[i];
+          memcpy(call.bytes[i],(const void *)transfers[i].tx_buf,3);
+        }
+      calls++;
+      return 3 * count;
+    }
+  else
+    {
+      errno = ENOTTY;
+      return -1;
+    }
+  
+  return 0;
+  
+}
+
+/* Checks that the last SPI_IOC_MESSAGE was count messages (their
+   frames in expected as header << 16 | data, or any frames if
+   expected is null) with the chip select going high between them.
+*/
+static void checkMessage (const char *name, unsigned int count,
+                          const unsigned long expected[])
+{
+  
+  if (calls == 0)
+    {
+      check(name,0,1);
+      return;
+    }
+  const Call &call = recorded[(calls - 1) % MAX_CALLS];
+  
+  char what[64];
+  snprintf(what,sizeof(what),"%s transfers",name);
+  check(what,call.count,count);
+  
+  for (unsigned int i = 0; i < call.count && i < count; i++)
+    {
+      const struct spi_ioc_transfer &transfer = call.transfers[i];
+      snprintf(what,sizeof(what),"%s %u len",name,i);
+      check(what,transfer.len,3);
+      snprintf(what,sizeof(what),"%s %u cs_change",name,i);
+      check(what,transfer.cs_change,i + 1 < count ? 1 : 0);
+      snprintf(what,sizeof(what),"%s %u speed_hz",name,i);
+      check(what,transfer.speed_hz,2000000);
+      snprintf(what,sizeof(what),"%s %u rx_buf",name,i);
+      check(what,transfer.rx_buf,0);
+      if (expected != 0)
+        {
+          snprintf(what,sizeof(what),"%s %u frame",name,i);
+          check(what,((unsigned long)call.bytes[i][0] << 16)
+                | ((unsigned long)call.bytes[i][1] << 8)
+                | call.bytes[i][2],expected[i]);
+        }
+    }
+  
+}
+
+int main ()
+{
+  
+  typedef AD56X4Commands<AD56X4Spidev> DAC;
+  AD56X4Spidev dac;
+  
+  check("open",dac.open("/dev/null",2000000),true);
+  check("mode",mode,SPI_MODE_1);
+  check("lsbFirst",lsbFirst,0);
+  check("bitsPerWord",bitsPerWord,8);
+  check("maxSpeed",maxSpeed,2000000);
+  
+  // A message by itself is one ioctl.
+  
+  DAC::setChannel(dac,AD56X4_SETMODE_INPUT_DAC,AD56X4_CHANNEL_A,
+                  0x1234);
+  check("single calls",calls,1);
+  const unsigned long single[] = {0x181234};
+  checkMessage("single",1,single);
+  
+  // A burst is one ioctl.
+  
+  DAC::commitChannels(dac,1,2,3,4);
+  check("burst calls",calls,2);
+  const unsigned long burst[] = {0x030001, 0x020002, 0x010003,
+                                 0x100004};
+  checkMessage("burst",4,burst);
+  
+  // A batch is collected and sent in one ioctl at the end.
+  
+  dac.beginBatch();
+  DAC::setChannel(dac,AD56X4_SETMODE_INPUT,AD56X4_CHANNEL_B,0xABCD);
+  DAC::setChannel(dac,AD56X4_SETMODE_INPUT,AD56X4_CHANNEL_C,0x00FF);
+  DAC::updateChannel(dac,AD56X4_CHANNEL_ALL);
+  check("batch held",calls,2);
+  check("batch pending",dac.pending(),3);
+  check("batch endBatch",dac.endBatch(),true);
+  check("batch calls",calls,3);
+  check("batch sent",dac.pending(),0);
+  const unsigned long batch[] = {0x01abcd, 0x0200ff, 0x0f0000};
+  checkMessage("batch",3,batch);
+  
+  // A batch that fills up is sent when the next message comes, and
+  // the rest at the end.
+  
+  dac.beginBatch();
+  for (unsigned int i = 0; i < AD56X4_SPIDEV_BATCH; i++)
+    DAC::setChannel(dac,AD56X4_SETMODE_INPUT,AD56X4_CHANNEL_A,i);
+  check("full held",calls,3);
+  check("full pending",dac.pending(),AD56X4_SPIDEV_BATCH);
+  for (unsigned int i = 0; i < 5; i++)
+    DAC::setChannel(dac,AD56X4_SETMODE_INPUT,AD56X4_CHANNEL_A,i);
+  check("full flushed",calls,4);
+  checkMessage("full",AD56X4_SPIDEV_BATCH,0);
+  check("full last",recorded[3].bytes[AD56X4_SPIDEV_BATCH - 1][2],
+        (AD56X4_SPIDEV_BATCH - 1) & 0xFF);
+  check("full pending after",dac.pending(),5);
+  dac.flush();
+  check("full rest",calls,5);
+  checkMessage("rest",5,0);
+  dac.endBatch();
+  check("empty endBatch",calls,5);
+  
+  // A failed ioctl is reported, and the messages dropped.
+  
+  failWith = EIO;
+  dac.beginBatch();
+  DAC::reset(dac,true);
+  check("failed endBatch",dac.endBatch(),false);
+  check("failed error",dac.error(),EIO);
+  check("failed dropped",dac.pending(),0);
+  failWith = 0;
+  
+  // The bus owns the file descriptor, so it can't be copied.
+  
+  check("copy constructible",
+        std::is_copy_constructible<AD56X4Spidev>::value,false);
+  check("copy assignable",
+        std::is_copy_assignable<AD56X4Spidev>::value,false);
+  
+  dac.close();
+  
+  printf("spidevtest: %d checks, %d failed\n",checks,failures);
+  puts(failures == 0 ? "spidevtest: passed" : "spidevtest: FAILED");
+  return failures == 0 ? 0 : 1;
+  
+}
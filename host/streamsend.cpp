@@ -0,0 +1,396 @@
+/* Copyright (c) 2026, Freja Nordsiek
+   All rights reserved.
+   
+   Redistribution and use in source and binary forms, with or
+   without modification, are permitted provided that the
+   following conditions are met:
+   
+   1. Redistributions of source code must retain the above
+   copyright notice, this list of conditions and the following disclaimer.
+   
+   2. Redistributions in binary form must reproduce the above
+   copyright notice, this list of conditions and the following
+   disclaimer in the documentation and/or other materials
+   provided with the distribution.
+   
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+   NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+   LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+   HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+   OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*
+   streamsend.cpp: Reference sender of samples to an
+                   AD56X4StreamReceiver (see AD56X4Stream.h) over a
+                   serial port, for a POSIX PC.
+   
+   Author:   Freja Nordsiek
+   Notes:    Host builds only. Not part of the Arduino library.
+             Build with "make host/streamsend".
+   History:  * 2026-10-16 Created.
+*/
+
+/* Usage: streamsend [-b baud] [-k block] [-n count] device [file]
+   
+   Resets the stream (retrying every half second until acknowledged,
+   since opening the port resets most Arduinos), and then sends
+   samples in blocks of at most block samples (8 by default), never
+   more than it has credit for, until count samples (100000 by
+   default) have been sent. The samples are read from file ("-" for
+   standard input) in the same format they are sent in (the four
+   channel values in channel D to A order, each low byte first), or
+   if there is no file, are a test pattern where sample k has k, 2k,
+   3k, and 4k (mod 65536) on channels A to D. Whenever the receiver
+   asks it to resync (or acknowledges a reset it didn't send), it
+   resets the stream again, without sending any samples until that is
+   acknowledged. When done, it waits for the receiver to drain
+   everything and prints the rate achieved.
+*/
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <time.h>
+#include <unistd.h>
+
+// The same as in AD56X4Stream.h.
+
+#define AD56X4_STREAM_SYNC 0xA5
+#define AD56X4_STREAM_CREDIT 0x5A
+#define AD56X4_STREAM_RESET_ACK 0x5B
+#define AD56X4_STREAM_RESYNC 0x5C
+
+static int port = -1;
+
+// Credit given by the receiver and not yet used, the most it has
+// ever given at once (the ring length), and whether the last reset
+// has been acknowledged (false while one is needed or in flight).
+
+static unsigned long credit = 0;
+static unsigned long ringLength = 0;
+static bool acknowledged = false;
+
+static double nowSeconds ()
+{
+  struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC,&t);
+  return t.tv_sec + 1e-9 * t.tv_nsec;
+}
+
+static speed_t toSpeed (long baud)
+{
+  switch (baud)
+    {
+      case 9600: return B9600;
+      case 19200: return B19200;
+      case 38400: return B38400;
+      case 57600: return B57600;
+      case 115200: return B115200;
+      case 230400: return B230400;
+#if defined(B460800)
+      case 460800: return B460800;
+#endif
+#if defined(B500000)
+      case 500000: return B500000;
+#endif
+#if defined(B921600)
+      case 921600: return B921600;
+#endif
+#if defined(B1000000)
+      case 1000000: return B1000000;
+#endif
+#if defined(B2000000)
+      case 2000000: return B2000000;
+#endif
+      default: return B0;
+    }
+}
+
+/* Opens the serial port in raw mode (8N1, no flow control, nothing
+   translated).
+*/
+static bool openPort (const char *device, long baud)
+{
+  
+  speed_t speed = toSpeed(baud);
+  if (speed == B0)
+    {
+      fprintf(stderr,"streamsend: unsupported baud rate %ld\n",baud);
+      return false;
+    }
+  
+  port = open(device,O_RDWR | O_NOCTTY);
+  if (port < 0)
+    {
+      fprintf(stderr,"streamsend: %s: %s\n",device,strerror(errno));
+      return false;
+    }
+  
+  struct termios settings;
+  if (tcgetattr(port,&settings) != 0)
+    {
+      fprintf(stderr,"streamsend: %s: %s\n",device,strerror(errno));
+      return false;
+    }
+  cfmakeraw(&settings);
+  settings.c_cflag |= CLOCAL | CREAD;
+  settings.c_cflag &= ~CRTSCTS;
+  settings.c_cc[VMIN] = 0;
+  settings.c_cc[VTIME] = 0;
+  cfsetispeed(&settings,speed);
+  cfsetospeed(&settings,speed);
+  if (tcsetattr(port,TCSANOW,&settings) != 0)
+    {
+      fprintf(stderr,"streamsend: %s: %s\n",device,strerror(errno));
+      return false;
+    }
+  tcflush(port,TCIOFLUSH);
+  
+  return true;
+  
+}
+
+static bool writeAll (const uint8_t *data, size_t length)
+{
+  while (length > 0)
+    {
+      ssize_t n = write(port,data,length);
+      if (n < 0)
+        {
+          if (errno == EINTR || errno == EAGAIN)
+            continue;
+          perror("streamsend: write");
+          return false;
+        }
+      data += n;
+      length -= n;
+    }
+  return true;
+}
+
+/* Waits up to timeout seconds for something from the receiver and
+   takes the credit in it. Credit before the reset is acknowledged is
+   from before the reset and is ignored. A request to resync, or an
+   acknowledgement of a reset that wasn't sent (the receiver took
+   something else for one), means a reset is needed.
+*/
+static bool receiveCredit (double timeout)
+{
+  
+  static int type = -1;
+  
+  struct pollfd p;
+  p.fd = port;
+  p.events = POLLIN;
+  if (poll(&p,1,(int)(timeout * 1000)) < 0 && errno != EINTR)
+    {
+      perror("streamsend: poll");
+      return false;
+    }
+  
+  uint8_t buffer[256];
+  ssize_t n = read(port,buffer,sizeof(buffer));
+  if (n < 0 && errno != EAGAIN && errno != EINTR)
+    {
+      perror("streamsend: read");
+      return false;
+    }
+  
+  for (ssize_t i = 0; i < n; i++)
+    {
+      if (type < 0)
+        {
+          if (buffer[i] == AD56X4_STREAM_CREDIT
+              || buffer[i] == AD56X4_STREAM_RESET_ACK
+              || buffer[i] == AD56X4_STREAM_RESYNC)
+            type = buffer[i];
+          continue;
+        }
+      
+      if (type == AD56X4_STREAM_RESET_ACK && !acknowledged)
+        {
+          acknowledged = true;
+          credit = buffer[i];
+          if (credit > ringLength)
+            ringLength = credit;
+        }
+      else if (type != AD56X4_STREAM_CREDIT)
+        acknowledged = false;
+      else if (acknowledged)
+        credit += buffer[i];
+      type = -1;
+    }
+  
+  return true;
+  
+}
+
+/* Resets the stream, waiting the whole half second for the
+   acknowledgement before trying again (a second reset would throw
+   away samples sent on the credit from the first).
+*/
+static bool resetStream ()
+{
+  static const uint8_t reset[] = {AD56X4_STREAM_SYNC, 0, 0};
+  for (int tries = 0; !acknowledged; tries++)
+    {
+      if (tries == 20)
+        {
+          fprintf(stderr,"streamsend: no reply from the receiver\n");
+          return false;
+        }
+      if (!writeAll(reset,sizeof(reset)))
+        return false;
+      double deadline = nowSeconds() + 0.5;
+      while (!acknowledged && nowSeconds() < deadline)
+        if (!receiveCredit(deadline - nowSeconds()))
+          return false;
+    }
+  return true;
+}
+
+/* Sends count samples in one block. */
+static bool sendBlock (const uint8_t *samples, int count)
+{
+  uint8_t block[3 + 255 * 8];
+  block[0] = AD56X4_STREAM_SYNC;
+  block[1] = count;
+  memcpy(block + 2,samples,count * 8);
+  uint8_t sum = count;
+  for (int i = 0; i < count * 8; i++)
+    sum += samples[i];
+  block[2 + count * 8] = -sum;
+  return writeAll(block,3 + count * 8);
+}
+
+/* Gets the next count samples from file, or the test pattern if
+   there is no file. Returns how many there were.
+*/
+static int getSamples (FILE *file, unsigned long first,
+                       uint8_t *samples, int count)
+{
+  if (file != 0)
+    return fread(samples,8,count,file);
+  
+  for (int k = 0; k < count; k++)
+    for (int i = 0; i < 4; i++)
+      {
+        uint16_t value = (first + k) * (i + 1);
+        samples[8 * k + 2 * (3 - i)] = value & 0xFF;
+        samples[8 * k + 2 * (3 - i) + 1] = value >> 8;
+      }
+  return count;
+}
+
+int main (int argc, char *argv[])
+{
+  
+  long baud = 115200;
+  int blockLength = 8;
+  unsigned long count = 100000;
+  
+  int option;
+  while ((option = getopt(argc,argv,"b:k:n:")) != -1)
+    switch (option)
+      {
+        case 'b': baud = strtol(optarg,0,10); break;
+        case 'k': blockLength = atoi(optarg); break;
+        case 'n': count = strtoul(optarg,0,10); break;
+        default:
+          fprintf(stderr,"Usage: streamsend [-b baud] [-k block] "
+                  "[-n count] device [file]\n");
+          return 2;
+      }
+  if (optind >= argc || blockLength < 1 || blockLength > 255)
+    {
+      fprintf(stderr,"Usage: streamsend [-b baud] [-k block] "
+              "[-n count] device [file]\n");
+      return 2;
+    }
+  
+  FILE *file = 0;
+  if (optind + 1 < argc)
+    {
+      const char *name = argv[optind + 1];
+      file = strcmp(name,"-") == 0 ? stdin : fopen(name,"rb");
+      if (file == 0)
+        {
+          fprintf(stderr,"streamsend: %s: %s\n",name,strerror(errno));
+          return 1;
+        }
+    }
+  
+  if (!openPort(argv[optind],baud))
+    return 1;
+  
+  if (!resetStream())
+    return 1;
+  
+  // Send the samples, waiting for credit whenever there isn't any
+  // and resetting the stream whenever the receiver asks.
+  
+  double start = nowSeconds();
+  unsigned long sent = 0;
+  uint8_t samples[255 * 8];
+  
+  while (sent < count)
+    {
+      
+      if (!receiveCredit(credit == 0 ? 1.0 : 0))
+        return 1;
+      if (!acknowledged && !resetStream())
+        return 1;
+      if (credit == 0)
+        continue;
+      
+      unsigned long n = blockLength;
+      if (n > credit)
+        n = credit;
+      if (n > count - sent)
+        n = count - sent;
+      
+      n = getSamples(file,sent,samples,n);
+      if (n == 0)
+        break;
+      if (!sendBlock(samples,n))
+        return 1;
+      
+      credit -= n;
+      sent += n;
+      
+    }
+  
+  // Wait for the receiver to drain everything (all the credit to come
+  // back).
+  
+  double timeout = nowSeconds() + 5;
+  while ((credit < ringLength || !acknowledged)
+         && nowSeconds() < timeout)
+    {
+      if (!receiveCredit(0.1))
+        return 1;
+      if (!acknowledged && !resetStream())
+        return 1;
+    }
+  
+  double elapsed = nowSeconds() - start;
+  printf("streamsend: %lu samples in %.3f s (%.0f samples/s)\n",sent,
+         elapsed,sent / elapsed);
+  
+  return credit < ringLength ? 1 : 0;
+  
+}
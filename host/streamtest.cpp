@@ -0,0 +1,242 @@
+/* Copyright (c) 2026, Freja Nordsiek
+   All rights reserved.
+   
+   Redistribution and use in source and binary forms, with or
+   without modification, are permitted provided that the
+   following conditions are met:
+   
+   1. Redistributions of source code must retain the above
+   copyright notice, this list of conditions and the following disclaimer.
+   
+   2. Redistributions in binary form must reproduce the above
+   copyright notice, this list of conditions and the following
+   disclaimer in the documentation and/or other materials
+   provided with the distribution.
+   
+   THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+   CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+   INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+   MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+   DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+   CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+   SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+   NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+   LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+   HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+   CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+   OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+   SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+/*
+   streamtest.cpp: Test of AD56X4StreamReceiver (see AD56X4Stream.h)
+                   against the reference sender (streamsend.cpp) over
+                   a pseudo-terminal standing in for the serial port.
+   
+   Author:   Freja Nordsiek
+   Notes:    Host builds only. Not part of the Arduino library.
+             Build and run with "make streamtest".
+   History:  * 2026-10-16 Created.
+*/
+
+/* Usage: streamtest [-c offset] [-d offset] [sender [rate [count]]]
+   
+   Opens a pseudo-terminal and runs the sender (./host/streamsend by
+   default) on its slave end sending count samples (20000 by
+   default) of its test pattern, while the receiver reads the master
+   end and the samples are drained at rate samples a second (5000 by
+   default), like a sample clock would. Every sample drained is
+   checked against the test pattern. Exits with 1 if any sample is
+   wrong or missing, or a block was bad or overflowed the ring.
+   
+   With -c, the byte at offset in what the sender sends is corrupted
+   (made 0xFF), and with -d, it is dropped. Then the receiver must
+   see an error and get the sender to resync, the samples drained
+   must still be in order (though some are missing) with none wrong,
+   and the sender must get all its credit back in the end.
+*/
+
+#include <errno.h>
+#include <fcntl.h>
+#include <getopt.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/ioctl.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "Arduino.h"
+#include <AD56X4Stream.h>
+
+/* The master end of the pseudo-terminal as a serial port, with the
+   available, read, and write of Serial. The byte at offset corrupt
+   (if not negative) is made 0xFF, and the one at offset drop is
+   dropped.
+*/
+class PtyPort
+{
+  
+  public:
+  
+    PtyPort (int fd, long corrupt, long drop)
+      : fd(fd), length(0), index(0), offset(0), corrupt(corrupt),
+        drop(drop) {}
+    
+    int available ()
+    {
+      if (index == length)
+        {
+          ssize_t n = ::read(fd,buffer,sizeof(buffer));
+          length = 0;
+          for (ssize_t i = 0; i < n; i++, offset++)
+            if (offset == corrupt)
+              buffer[length++] = 0xFF;
+            else if (offset != drop)
+              buffer[length++] = buffer[i];
+          index = 0;
+        }
+      return length - index;
+    }
+    int read ()
+    {
+      if (available() == 0)
+        return -1;
+      return buffer[index++];
+    }
+    size_t write (uint8_t value)
+    {
+      return ::write(fd,&value,1) == 1 ? 1 : 0;
+    }
+    
+  private:
+    
+    int fd;
+    uint8_t buffer[256];
+    int length;
+    int index;
+    long offset;
+    long corrupt;
+    long drop;
+    
+};
+
+int main (int argc, char *argv[])
+{
+  
+  long corrupt = -1;
+  long drop = -1;
+  
+  int option;
+  while ((option = getopt(argc,argv,"c:d:")) != -1)
+    switch (option)
+      {
+        case 'c': corrupt = strtol(optarg,0,10); break;
+        case 'd': drop = strtol(optarg,0,10); break;
+        default:
+          fprintf(stderr,"Usage: streamtest [-c offset] [-d offset] "
+                  "[sender [rate [count]]]\n");
+          return 2;
+      }
+  argc -= optind - 1;
+  argv += optind - 1;
+  boolean faulty = corrupt >= 0 || drop >= 0;
+  
+  const char *sender = argc > 1 ? argv[1] : "./host/streamsend";
+  unsigned long rate = argc > 2 ? strtoul(argv[2],0,10) : 5000;
+  unsigned long count = argc > 3 ? strtoul(argv[3],0,10) : 20000;
+  
+  int master = posix_openpt(O_RDWR | O_NOCTTY);
+  if (master < 0 || grantpt(master) != 0 || unlockpt(master) != 0)
+    {
+      perror("streamtest: posix_openpt");
+      return 1;
+    }
+  fcntl(master,F_SETFL,fcntl(master,F_GETFL) | O_NONBLOCK);
+  
+  char countText[16];
+  snprintf(countText,sizeof(countText),"%lu",count);
+  
+  pid_t child = fork();
+  if (child == 0)
+    {
+      execl(sender,sender,"-n",countText,ptsname(master),(char *)0);
+      perror("streamtest: exec");
+      _exit(1);
+    }
+  
+  PtyPort port(master,corrupt,drop);
+  AD56X4StreamReceiver<PtyPort> stream(port);
+  
+  // Drain at the rate, checking every sample, until the sender is
+  // done and everything has been drained. Sample k of the pattern
+  // has k on channel A, so a sample is wrong if the other channels
+  // don't agree with it or it isn't after the last one (or, without
+  // faults, isn't the one right after it).
+  
+  unsigned long checked = 0;
+  unsigned long wrong = 0;
+  long last = -1;
+  unsigned long period = 1000000 / rate;
+  unsigned long nextTime = micros();
+  unsigned long giveUp = millis() + 60000;
+  int status = -1;
+  
+  while ((status < 0 || stream.available() != 0)
+         && (long)(millis() - giveUp) < 0)
+    {
+      
+      stream.poll();
+      
+      if ((long)(micros() - nextTime) >= 0)
+        {
+          nextTime += period;
+          word values[4];
+          if (stream.next(values))
+            {
+              long k = values[3];
+              boolean bad = k <= last || (!faulty && k != last + 1);
+              for (int i = 1; i < 4; i++)
+                if (values[3-i] != (word)(k * (i + 1)))
+                  bad = true;
+              if (bad)
+                wrong++;
+              last = k;
+              checked++;
+            }
+        }
+      else
+        usleep(10);
+      
+      int childStatus;
+      if (status < 0 && waitpid(child,&childStatus,WNOHANG) == child)
+        status = WIFEXITED(childStatus) ? WEXITSTATUS(childStatus)
+                 : 1;
+      
+    }
+  
+  if (status < 0)
+    {
+      kill(child,SIGTERM);
+      waitpid(child,0,0);
+    }
+  
+  printf("streamtest: %lu received, %lu checked, %lu wrong, "
+         "%lu underruns, %lu errors, %lu overflows, sender %d\n",
+         stream.received(),checked,wrong,stream.underruns(),
+         stream.errors(),stream.overflows(),status);
+  
+  // With a fault, no more than the samples the sender had credit
+  // for around the fault (two rings and a block) may be missing.
+  
+  boolean passed = status == 0 && wrong == 0
+                   && stream.overflows() == 0
+                   && checked == stream.received();
+  if (faulty)
+    passed = passed && stream.errors() != 0
+             && count - checked <= 2 * AD56X4_STREAM_LENGTH + 255;
+  else
+    passed = passed && checked == count && stream.errors() == 0;
+  puts(passed ? "streamtest: passed" : "streamtest: FAILED");
+  return passed ? 0 : 1;
+  
+}